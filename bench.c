@@ -0,0 +1,520 @@
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "cvec.h"
+#include "cvec_concurrent.h"
+
+/* The amount of elements the single-threaded cases work on, and the amount for the cases
+ * that move the elements on every operation */
+#define BENCH_ELEMS         (1u << 16)
+#define BENCH_SMALL_ELEMS   (1u << 12)
+#define BENCH_PUSHARR_LEN   64
+
+/* Every case is repeated until it ran for at least this long, in seconds */
+#define BENCH_MIN_TIME      0.05
+
+#define BENCH_ITEMS         (1u << 21)
+#define BENCH_MAX_THREADS   64
+#define BENCH_QUEUE_SIZE    1024
+
+/* The amount of round trips of the ping-pong case, and the amount of failed attempts
+ * to pass an item after which a waiting thread yields the processor */
+#define BENCH_ROUND_TRIPS   (1u << 18)
+#define BENCH_SPINS         256
+
+/* The elements of the single-threaded cases. Their key is what they're sorted by */
+typedef struct elem4 { unsigned int key; } elem4;
+typedef struct elem16 { unsigned int key; char pad[12]; } elem16;
+typedef struct elem64 { unsigned int key; char pad[60]; } elem64;
+typedef struct elem256 { unsigned int key; char pad[252]; } elem256;
+
+using_vec_type(int);
+using_vec_type(elem4);
+using_vec_type(elem16);
+using_vec_type(elem64);
+using_vec_type(elem256);
+using_vec_spsc(int);
+using_vec_mpmc(int);
+
+typedef struct
+{
+    vec_type(int) vec;
+    pthread_mutex_t lock;
+} locked_vec;
+
+typedef struct
+{
+    void *queue;
+    unsigned int items;
+} bench_arg;
+
+/* The two queues of the ping-pong case, one for each direction */
+typedef struct
+{
+    vec_spsc_type(int) ping;
+    vec_spsc_type(int) pong;
+} spsc_pair;
+
+/* Keeps the compiler from optimizing away the values the cases read */
+static volatile unsigned int sink;
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Prints a result as a tab separated line: case, element size, threads, operations,
+ * nanoseconds per operation and millions of operations per second */
+static void report(const char *name, size_t elem_size, unsigned int threads, double ops, double elapsed)
+{
+    printf("%s\t%lu\t%u\t%.0f\t%.2f\t%.2f\n", name, (unsigned long)elem_size, threads, ops,
+        elapsed / ops * 1e9, ops / elapsed / 1e6);
+}
+
+/* Fills the keys of the elements in ascending, descending or pseudo-random order */
+#define BENCH_KEY(order, i, n) \
+    ((order) == 0 ? (unsigned int)(i) : (order) == 1 ? (unsigned int)((n) - (i)) : \
+     (unsigned int)((i) * 2654435761u >> 7))
+
+/**
+ * Defines the single-threaded cases for a vec of type <code>type</code>.
+ * Each of them is run repeatedly until it ran for BENCH_MIN_TIME, and
+ * only the operations it measures are timed.
+ */
+#define define_bench(type) \
+    static int _VEC_CAT(cmp_, type)(const type *a, const type *b) { \
+        return (a->key > b->key) - (a->key < b->key); \
+    } \
+    \
+    static void _VEC_CAT(fill_, type)(vec_type(type) *v, unsigned int n, int order) { \
+        type e; \
+        unsigned int i; \
+        memset(&e, 0, sizeof(e)); \
+        vec_clear(type)(v); \
+        vec_reserve(type)(v, n); \
+        for (i = 0; i < n; ++i) { \
+            e.key = BENCH_KEY(order, i, n); \
+            vec_push(type)(v, e); \
+        } \
+    } \
+    \
+    /* Makes the elements circulate around the buffer end, keeping the size and the capacity */ \
+    static void _VEC_CAT(wrap_, type)(vec_type(type) *v) { \
+        type e; \
+        vec_size_t i, half = vec_size(type)(v) / 2; \
+        for (i = 0; i < half; ++i) { \
+            vec_unshift(type)(v, &e); \
+            vec_push(type)(v, e); \
+        } \
+    } \
+    \
+    static void _VEC_CAT(bench_, type)(void) { \
+        static const char *sort_names[] = { "sort_sorted", "sort_reversed", "sort_random" }; \
+        static const char *stable_names[] = { "stable_sort_sorted", "stable_sort_reversed", "stable_sort_random" }; \
+        vec_type(type) v; \
+        type e, arr[BENCH_PUSHARR_LEN]; \
+        unsigned int i, order; \
+        double ops, elapsed, start; \
+        \
+        memset(&e, 0, sizeof(e)); \
+        memset(arr, 0, sizeof(arr)); \
+        vec_init(type)(&v); \
+        \
+        /* Appending one element at a time to an empty vec, including its growth */ \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            vec_clear(type)(&v); \
+            start = now(); \
+            for (i = 0; i < BENCH_ELEMS; ++i) { \
+                e.key = i; \
+                vec_push(type)(&v, e); \
+            } \
+            elapsed += now() - start; \
+        } \
+        report("push", sizeof(type), 1, ops, elapsed); \
+        \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            vec_clear(type)(&v); \
+            start = now(); \
+            for (i = 0; i < BENCH_ELEMS; i += BENCH_PUSHARR_LEN) { \
+                vec_pusharr(type)(&v, arr, BENCH_PUSHARR_LEN); \
+            } \
+            elapsed += now() - start; \
+        } \
+        report("pusharr", sizeof(type), 1, ops, elapsed); \
+        \
+        /* Growing by reserving one more element than the capacity after the elements circulated. Every element moved counts as an operation */ \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            _VEC_CAT(fill_, type)(&v, BENCH_ELEMS, 0); \
+            _VEC_CAT(wrap_, type)(&v); \
+            start = now(); \
+            vec_reserve(type)(&v, vec_capacity(type)(&v) + 1); \
+            elapsed += now() - start; \
+        } \
+        report("reserve_wrapped", sizeof(type), 1, ops, elapsed); \
+        \
+        /* Using a full ring whose elements circulate as a queue in both directions */ \
+        _VEC_CAT(fill_, type)(&v, BENCH_ELEMS, 0); \
+        _VEC_CAT(wrap_, type)(&v); \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            start = now(); \
+            for (i = 0; i < BENCH_ELEMS; ++i) { \
+                vec_unshift(type)(&v, &e); \
+                vec_push(type)(&v, e); \
+            } \
+            elapsed += now() - start; \
+        } \
+        report("unshift_push_wrapped", sizeof(type), 1, ops, elapsed); \
+        \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            start = now(); \
+            for (i = 0; i < BENCH_ELEMS; ++i) { \
+                vec_pop(type)(&v, &e); \
+                vec_shift(type)(&v, e); \
+            } \
+            elapsed += now() - start; \
+        } \
+        report("pop_shift_wrapped", sizeof(type), 1, ops, elapsed); \
+        \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+            unsigned int sum = 0; \
+            start = now(); \
+            for (i = 0; i < BENCH_ELEMS; ++i) { \
+                sum += vec_get(type)(&v, i)->key; \
+            } \
+            elapsed += now() - start; \
+            sink += sum; \
+        } \
+        report("get_wrapped", sizeof(type), 1, ops, elapsed); \
+        \
+        /* Inserting and erasing in the middle, which moves half of the elements every time */ \
+        _VEC_CAT(fill_, type)(&v, BENCH_SMALL_ELEMS, 0); \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_SMALL_ELEMS) { \
+            start = now(); \
+            for (i = 0; i < BENCH_SMALL_ELEMS; ++i) { \
+                vec_insert(type)(&v, e, vec_size(type)(&v) / 2); \
+            } \
+            elapsed += now() - start; \
+            vec_poparr(type)(&v, BENCH_SMALL_ELEMS, NULL); \
+        } \
+        report("insert_middle", sizeof(type), 1, ops, elapsed); \
+        \
+        for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_SMALL_ELEMS) { \
+            _VEC_CAT(fill_, type)(&v, BENCH_SMALL_ELEMS * 2, 0); \
+            start = now(); \
+            for (i = 0; i < BENCH_SMALL_ELEMS; ++i) { \
+                vec_erase(type)(&v, vec_size(type)(&v) / 2, 1, NULL); \
+            } \
+            elapsed += now() - start; \
+        } \
+        report("erase_middle", sizeof(type), 1, ops, elapsed); \
+        \
+        /* Sorting in the three orders. Every element counts as an operation */ \
+        for (order = 0; order < 3; ++order) { \
+            for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+                _VEC_CAT(fill_, type)(&v, BENCH_ELEMS, (int)order); \
+                start = now(); \
+                vec_sort(type)(&v, _VEC_CAT(cmp_, type)); \
+                elapsed += now() - start; \
+            } \
+            report(sort_names[order], sizeof(type), 1, ops, elapsed); \
+            \
+            for (ops = 0, elapsed = 0; elapsed < BENCH_MIN_TIME; ops += BENCH_ELEMS) { \
+                _VEC_CAT(fill_, type)(&v, BENCH_ELEMS, (int)order); \
+                start = now(); \
+                vec_stable_sort(type)(&v, _VEC_CAT(cmp_, type), NULL); \
+                elapsed += now() - start; \
+            } \
+            report(stable_names[order], sizeof(type), 1, ops, elapsed); \
+        } \
+        \
+        vec_clear(type)(&v); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a define_bench declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_bench, vec_cmp_type(type))
+
+define_bench(elem4);
+define_bench(elem16);
+define_bench(elem64);
+define_bench(elem256);
+
+/* Counts a failed attempt to pass an item, and yields after a run of them, so the other
+ * thread gets to run when there are fewer processors than threads */
+static void backoff(unsigned int *spins)
+{
+    if (++*spins >= BENCH_SPINS)
+    {
+        *spins = 0;
+        sched_yield();
+    }
+}
+
+static void* spsc_producer(void *arg)
+{
+    vec_spsc_type(int) *q = (vec_spsc_type(int) *)((bench_arg *)arg)->queue;
+    unsigned int i = 0, spins = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        val = (int)i;
+        while (!vec_spsc_try_push(int)(q, &val))
+        {
+            backoff(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+static void* spsc_consumer(void *arg)
+{
+    vec_spsc_type(int) *q = (vec_spsc_type(int) *)((bench_arg *)arg)->queue;
+    unsigned int i = 0, spins = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        while (!vec_spsc_try_pop(int)(q, &val))
+        {
+            backoff(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+/* Sends every item back on the other queue as soon as it arrives */
+static void* spsc_ponger(void *arg)
+{
+    spsc_pair *pair = (spsc_pair *)((bench_arg *)arg)->queue;
+    unsigned int i = 0, spins = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        while (!vec_spsc_try_pop(int)(&pair->ping, &val))
+        {
+            backoff(&spins);
+        }
+
+        while (!vec_spsc_try_push(int)(&pair->pong, &val))
+        {
+            backoff(&spins);
+        }
+    }
+
+    return NULL;
+}
+
+/* Sends an item and waits for it to come back before sending the next one */
+static void* spsc_pinger(void *arg)
+{
+    spsc_pair *pair = (spsc_pair *)((bench_arg *)arg)->queue;
+    unsigned int i = 0, spins = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        val = (int)i;
+        while (!vec_spsc_try_push(int)(&pair->ping, &val))
+        {
+            backoff(&spins);
+        }
+
+        while (!vec_spsc_try_pop(int)(&pair->pong, &val))
+        {
+            backoff(&spins);
+        }
+
+        sink += (unsigned int)val;
+    }
+
+    return NULL;
+}
+
+static void* mpmc_producer(void *arg)
+{
+    vec_mpmc_type(int) *q = (vec_mpmc_type(int) *)((bench_arg *)arg)->queue;
+    unsigned int i = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        val = (int)i;
+        vec_mpmc_push(int)(q, &val);
+    }
+
+    return NULL;
+}
+
+static void* mpmc_consumer(void *arg)
+{
+    vec_mpmc_type(int) *q = (vec_mpmc_type(int) *)((bench_arg *)arg)->queue;
+    unsigned int i = 0;
+    int val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; ++i)
+    {
+        vec_mpmc_pop(int)(q, &val);
+    }
+
+    return NULL;
+}
+
+static void* locked_producer(void *arg)
+{
+    locked_vec *q = (locked_vec *)((bench_arg *)arg)->queue;
+    unsigned int i = 0;
+    int pushed = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; i += pushed)
+    {
+        pthread_mutex_lock(&q->lock);
+        pushed = (vec_size(int)(&q->vec) < BENCH_QUEUE_SIZE && vec_push(int)(&q->vec, (int)i));
+        pthread_mutex_unlock(&q->lock);
+
+        if (!pushed)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* locked_consumer(void *arg)
+{
+    locked_vec *q = (locked_vec *)((bench_arg *)arg)->queue;
+    unsigned int i = 0;
+    int popped = 0, val = 0;
+
+    for (i = 0; i < ((bench_arg *)arg)->items; i += popped)
+    {
+        pthread_mutex_lock(&q->lock);
+        popped = vec_unshift(int)(&q->vec, &val);
+        pthread_mutex_unlock(&q->lock);
+
+        if (!popped)
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* Runs the given amount of producer and consumer pairs over a queue, each passing the given
+ * amount of items in total, and returns the elapsed time */
+static double run_pairs(void *queue, void *(*producer)(void *), void *(*consumer)(void *), unsigned int pairs, unsigned int items)
+{
+    pthread_t threads[BENCH_MAX_THREADS * 2];
+    bench_arg arg;
+    unsigned int i = 0;
+    double start = 0;
+
+    arg.queue = queue;
+    arg.items = items / pairs;
+
+    start = now();
+
+    for (i = 0; i < pairs; ++i)
+    {
+        if (pthread_create(&threads[i * 2], NULL, producer, &arg) ||
+            pthread_create(&threads[i * 2 + 1], NULL, consumer, &arg))
+        {
+            fputs("failed to start a thread\n", stderr);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (i = 0; i < pairs * 2; ++i)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    return now() - start;
+}
+
+/* Passes items between pairs of threads. Every item that was pushed and popped counts as an operation.
+ * The SPSC queue only takes a single pair; its ping-pong case counts every pass of an item from one
+ * thread to the other, so its time per operation is the handoff latency */
+static void bench_queues(unsigned int max_pairs)
+{
+    vec_spsc_type(int) spsc;
+    spsc_pair pair;
+    vec_mpmc_type(int) mpmc;
+    locked_vec locked;
+    unsigned int pairs = 0;
+    double items = 0;
+
+    if (!vec_spsc_init(int)(&spsc, BENCH_QUEUE_SIZE, NULL) || !vec_spsc_init(int)(&pair.ping, 1, NULL) ||
+        !vec_spsc_init(int)(&pair.pong, 1, NULL) || !vec_mpmc_init(int)(&mpmc, BENCH_QUEUE_SIZE, NULL) ||
+        !vec_init(int)(&locked.vec) || !vec_reserve(int)(&locked.vec, BENCH_QUEUE_SIZE) ||
+        pthread_mutex_init(&locked.lock, NULL))
+    {
+        fputs("failed to initialize the queues\n", stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    report("spsc_queue", sizeof(int), 2, (double)BENCH_ITEMS, run_pairs(&spsc, spsc_producer, spsc_consumer, 1, BENCH_ITEMS));
+    report("spsc_pingpong", sizeof(int), 2, (double)BENCH_ROUND_TRIPS * 2,
+        run_pairs(&pair, spsc_pinger, spsc_ponger, 1, BENCH_ROUND_TRIPS));
+
+    for (pairs = 1; pairs <= max_pairs; pairs *= 2)
+    {
+        items = (double)(BENCH_ITEMS / pairs * pairs);
+        report("mpmc_queue", sizeof(int), pairs * 2, items,
+            run_pairs(&mpmc, mpmc_producer, mpmc_consumer, pairs, BENCH_ITEMS));
+        report("mutex_queue", sizeof(int), pairs * 2, items,
+            run_pairs(&locked, locked_producer, locked_consumer, pairs, BENCH_ITEMS));
+    }
+
+    pthread_mutex_destroy(&locked.lock);
+    vec_clear(int)(&locked.vec);
+    vec_mpmc_release(int)(&mpmc);
+    vec_spsc_release(int)(&pair.pong);
+    vec_spsc_release(int)(&pair.ping);
+    vec_spsc_release(int)(&spsc);
+}
+
+int main(int argc, char *argv[])
+{
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    /* The thread count of the queue cases may be given explicitly. Every pair takes two of them */
+    if (argc > 1)
+    {
+        threads = atol(argv[1]);
+    }
+
+    if (threads < 2)
+    {
+        threads = 2;
+    }
+    else if (threads > BENCH_MAX_THREADS * 2)
+    {
+        threads = BENCH_MAX_THREADS * 2;
+    }
+
+    printf("# case\telem_size\tthreads\tops\tns_per_op\tmops_per_s\n");
+
+    bench_elem4();
+    bench_elem16();
+    bench_elem64();
+    bench_elem256();
+    bench_queues((unsigned int)threads / 2);
+
+    return EXIT_SUCCESS;
+}
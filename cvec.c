@@ -1,523 +1,1657 @@
-/**
- * @file    cvec.c
- * @author  Isaac Garzon
- * @since   24/02/2015
- *
- * @section DESCRIPTION
- *
- *  A generic vector implementation in ANSI C.
- *
- * @section LICENSE
- *
- *  Copyright (c) 2015 Isaac Garzon
- *
- *  Permission is hereby granted, free of charge, to any person obtaining a copy
- *  of this software and associated documentation files (the "Software"), to deal
- *  in the Software without restriction, including without limitation the rights
- *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- *  copies of the Software, and to permit persons to whom the Software is
- *  furnished to do so, subject to the following conditions:
- *
- *  The above copyright notice and this permission notice shall be included in
- *  all copies or substantial portions of the Software.
- *
- *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- *  THE SOFTWARE
- */
-
-#include <stdlib.h>
-#include <string.h>
-#include "cvec.h"
-
-#define VEC_DEFAULT_CAPACITY    5
-#define VEC_IDX(idx, max)       (((idx) + (max)) % (max))
-#define VEC_GET(vec, idx)       (&(vec)->_mem[(((vec)->start + (idx)) % (vec)->capacity) * (vec)->_t_size])
-#define IS_VALID_VEC(vec) \
-    ((vec) && ((vec)->_t_size) && \
-     ((!(vec)->capacity && !(vec)->_mem) || \
-      ((vec)->size <= (vec)->capacity && (vec)->start < (vec)->capacity)))
-
-_impl_vec_def_struct(unsigned char, _IMPL_VEC_STRUCT_NAME);
-
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-static void _vec_rotate(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *tmp)
-{
-    unsigned int count = 0;
-    unsigned int offset = 0;
-    unsigned int len = vec_ptr->capacity;
-    unsigned int tsize = vec_ptr->_t_size;
-
-    while (count < len)
-    {
-        unsigned int index = offset;
-        unsigned int next = (vec_ptr->start + index) % len;
-
-        memcpy(tmp, &vec_ptr->_mem[index * tsize], tsize);
-
-        while (next != offset)
-        {
-            memcpy(&vec_ptr->_mem[index * tsize], &vec_ptr->_mem[next * tsize], tsize);
-            ++count;
-
-            index = next;
-            next = (vec_ptr->start + index) % len;
-        }
-
-        memcpy(&vec_ptr->_mem[index * tsize], tmp, tsize);
-        ++count;
-        ++offset;
-    }
-
-    vec_ptr->start = 0;
-}
-
-static void _vec_align(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *tmp)
-{
-    int circular_items = (vec_ptr->start + vec_ptr->size) - vec_ptr->capacity;
-
-    /* Check if we actually need to align anything */
-    if (circular_items > 0)
-    {
-        /* Check if we can align without full rotation */
-        if (vec_ptr->capacity - vec_ptr->size < vec_ptr->size)
-        {
-            _vec_rotate(vec_ptr, tmp);
-        }
-        else
-        {
-            unsigned int offset = 0;
-            unsigned int tsize = vec_ptr->_t_size;
-            unsigned int items = vec_ptr->size;
-            unsigned int last = vec_ptr->start;
-            unsigned int end = items - vec_ptr->capacity + vec_ptr->start;
-
-            /* Copy the circulated items just behind vec_ptr->start */
-            while (end)
-            {
-                memcpy(&vec_ptr->_mem[--last * tsize], &vec_ptr->_mem[--end * tsize], tsize);
-            }
-
-            /* Copy items to the beginning of the buffer */
-            while ((offset < items) && (vec_ptr->start < vec_ptr->capacity))
-            {
-                memcpy(&vec_ptr->_mem[offset++ * tsize], &vec_ptr->_mem[vec_ptr->start++ * tsize], tsize);
-            }
-
-            /* Copy the circulated items from before to their right place */
-            while (offset < items)
-            {
-                memcpy(&vec_ptr->_mem[offset++ * tsize], &vec_ptr->_mem[last++ * tsize], tsize);
-            }
-
-            vec_ptr->start = 0;
-        }
-    }
-}
-
-static void _vec_swap(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int first, unsigned int second, void *tmp)
-{
-    memcpy(tmp, VEC_GET(vec_ptr, first), vec_ptr->_t_size);
-    memcpy(VEC_GET(vec_ptr, first), VEC_GET(vec_ptr, second), vec_ptr->_t_size);
-    memcpy(VEC_GET(vec_ptr, second), tmp, vec_ptr->_t_size);
-}
-
-static void _vec_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, void *tmp)
-{
-    /* Check if we actually need to sort anything */
-    if (vec_ptr->size)
-    {
-        /* Align the buffer so we can pass it to qsort */
-        _vec_align(vec_ptr, tmp);
-        qsort(VEC_GET(vec_ptr, 0), vec_ptr->size, vec_ptr->_t_size, cmpfn);
-    }
-}
-
-static int _vec_reserve(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int capacity)
-{
-    /* Check if we need to do anything */
-    if (capacity > vec_ptr->capacity)
-    {
-        unsigned char *new_mem;
-        int circular_items = (vec_ptr->start + vec_ptr->size) - vec_ptr->capacity;
-        int use_malloc = (circular_items > 0) && ((unsigned int)circular_items > capacity - vec_ptr->capacity);
-        unsigned int size = capacity * vec_ptr->_t_size;
-
-        /* Avoid integer overflow */
-        if (size / vec_ptr->_t_size != capacity)
-        {
-            return FALSE;
-        }
-
-        /* Naive optimization: if we have items that circulated to the beginning of vec_ptr->_mem,
-         * check if we can copy them back to the end in a single memcpy call. If so, use realloc
-         * to minimize allocation overhead. Otherwise, the amount of copy needed already creates
-         * a huge overhead. Simply use malloc and copy */
-        if (use_malloc)
-        {
-            new_mem = (unsigned char *)malloc(size);
-        }
-        else
-        {
-            new_mem = (unsigned char *)realloc(vec_ptr->_mem, size);
-        }
-
-        /* Check if allocation succeeded */
-        if (!new_mem)
-        {
-            return FALSE;
-        }
-
-        /* Check if there are items that circulated beyond the buffer end */
-        if (circular_items > 0)
-        {
-            if (!use_malloc)
-            {
-                memcpy(new_mem, VEC_GET(vec_ptr, 0), circular_items * vec_ptr->_t_size);
-            }
-            else
-            {
-                unsigned int bytes_at_end = (vec_ptr->capacity - (unsigned int)circular_items) * vec_ptr->_t_size;
-
-                /* We need to copy the items from vec_ptr->start until the end of the vec_ptr->_mem and
-                 * then copy the rest of the items from the beginning of vec_ptr->_mem */
-                memcpy(new_mem, VEC_GET(vec_ptr, 0), bytes_at_end);
-                memcpy(new_mem + bytes_at_end, vec_ptr->_mem, (unsigned int)circular_items * vec_ptr->_t_size);
-
-                /* We're now at the beginning of the memory block */
-                vec_ptr->start = 0;
-
-                /* Free the old memory */
-                free(vec_ptr->_mem);
-            }
-        }
-
-        /* Set the new values */
-        vec_ptr->_mem = new_mem;
-        vec_ptr->capacity = capacity;
-    }
-
-    return TRUE;
-}
-
-static int _vec_insert(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, const unsigned char *val, unsigned int len)
-{
-    /* Don't allow adding elements in arbitrary place that is beyond vec_ptr->size
-     * and avoid integer overflow */
-    if ((idx > vec_ptr->size) || (vec_ptr->size + len < vec_ptr->size))
-    {
-        return FALSE;
-    }
-
-    /* Check if we actually need to do anything */
-    if (len)
-    {
-        /* Check if we need to reserve more memory */
-        if (vec_ptr->size + len > vec_ptr->capacity)
-        {
-            unsigned int addition = (vec_ptr->capacity ? vec_ptr->capacity : VEC_DEFAULT_CAPACITY);
-
-            /* Make sure we have enough to store len elements */
-            while (addition < len)
-            {
-                addition <<= 1;
-            }
-
-            /* Avoid integer overflow */
-            if (vec_ptr->capacity + addition < vec_ptr->capacity)
-            {
-                addition = len;
-            }
-
-            /* Try to reserve place to fit at least len elements */
-            while (!_vec_reserve(vec_ptr, vec_ptr->capacity + addition))
-            {
-                /* Divide by two and try again unless reserve failed even for exactly len elemnts more */
-                if ((addition >>= 1) < len)
-                {
-                    return FALSE;
-                }
-            }
-        }
-
-        /* Perform all sorts of crazy calculations only if we already have some elements and
-         * we might need to move them around. Otherwise this is the first insertion, so simply
-         * put it in idx 0 and be done with it */
-        if (vec_ptr->size > 0)
-        {
-            /* Check if we can create free slot at idx with simple pointer regression */
-            if (idx == 0)
-            {
-                vec_ptr->start = VEC_IDX(vec_ptr->start - len, vec_ptr->capacity);
-            }
-            else if (idx < vec_ptr->size)
-            {
-                unsigned int free_idx = vec_ptr->size + len;
-                unsigned int elements = len;
-
-                /* Copy elements from the end of vec_ptr until idx len slots forward */
-                do
-                {
-                    memcpy(VEC_GET(vec_ptr, free_idx), VEC_GET(vec_ptr, free_idx - len), vec_ptr->_t_size);
-                    --free_idx, --elements;
-                } while (elements);
-            }
-        }
-
-		vec_ptr->size += len;
-
-		/* Copy len elements from val into the free slots */
-        do
-        {
-            memcpy(VEC_GET(vec_ptr, idx), val, vec_ptr->_t_size);
-            ++idx;
-            val += vec_ptr->_t_size;
-        } while (--len);
-    }
-
-    return TRUE;
-}
-
-static int _vec_remove(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, unsigned int len, void *opt_out_val)
-{
-    /* Make sure that the index is reachable */
-    if ((len > vec_ptr->size) || (vec_ptr->size - len < idx))
-    {
-        return FALSE;
-    }
-
-    /* Check if we actually need to do anything */
-    if (len)
-    {
-        /* Check if we need to copy the value that is being removed */
-        if (opt_out_val)
-        {
-            unsigned int curr_idx = 0;
-            unsigned char *out_ptr = (unsigned char *)opt_out_val;
-
-            /* Copy len elements to the output variable */
-            while (curr_idx < len)
-            {
-                memcpy(out_ptr, VEC_GET(vec_ptr, idx + curr_idx), vec_ptr->_t_size);
-                ++curr_idx;
-                out_ptr += vec_ptr->_t_size;
-            }
-        }
-
-        vec_ptr->size -= len;
-
-        /* Check if we need to shift elements around because of the removal */
-        if (vec_ptr->size)
-        {
-            /* Check if we can finish with a simple start pointer advancement */
-            if (idx == 0)
-            {
-                vec_ptr->start = VEC_IDX(vec_ptr->start + len, vec_ptr->capacity);
-            }
-            else if (idx < vec_ptr->size)
-            {
-                unsigned int free_idx = idx;
-                unsigned int used_idx = idx + len;
-
-                /* Shift items from used_idx until the end of vec_ptr len slots back */
-                do
-                {
-                    memcpy(VEC_GET(vec_ptr, free_idx), VEC_GET(vec_ptr, used_idx), vec_ptr->_t_size);
-                    ++free_idx, ++used_idx;
-                } while (free_idx < vec_ptr->size);
-            }
-        }
-    }
-
-    return TRUE;
-}
-
-int _impl_vec_init(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int t_size)
-{
-    if ((!vec_ptr) || (!t_size))
-    {
-        return FALSE;
-    }
-
-    memset(vec_ptr, 0, sizeof(_IMPL_VEC_STRUCT_NAME));
-    vec_ptr->_t_size = t_size;
-
-    return TRUE;
-}
-
-int _impl_vec_reserve(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int capacity)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return FALSE;
-    }
-
-    return _vec_reserve(vec_ptr, capacity);
-}
-
-unsigned int _impl_vec_size(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return 0;
-    }
-
-    return vec_ptr->size;
-}
-
-unsigned int _impl_vec_capacity(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return 0;
-    }
-
-    return vec_ptr->capacity;
-}
-
-void* _impl_vec_get(const _IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx)
-{
-    if (!IS_VALID_VEC(vec_ptr) || (idx >= vec_ptr->size))
-    {
-        return NULL;
-    }
-
-    return VEC_GET(vec_ptr, idx);
-}
-
-void* _impl_vec_last(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
-{
-    if (!IS_VALID_VEC(vec_ptr) || !vec_ptr->size)
-    {
-        return NULL;
-    }
-
-    return VEC_GET(vec_ptr, vec_ptr->size - 1);
-}
-
-int _impl_vec_assign(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, const void *val)
-{
-    if (!IS_VALID_VEC(vec_ptr) || idx >= vec_ptr->size || !val)
-    {
-        return FALSE;
-    }
-
-    memcpy(VEC_GET(vec_ptr, idx), val, vec_ptr->_t_size);
-    return TRUE;
-}
-
-int _impl_vec_swap(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int first, unsigned int second, void *tmp)
-{
-    if (!IS_VALID_VEC(vec_ptr) || (first >= vec_ptr->size) || (second >= vec_ptr->size))
-    {
-        return FALSE;
-    }
-
-    /* Check if we actually need to do anything */
-    if (first != second)
-    {
-        _vec_swap(vec_ptr, first, second, tmp);
-    }
-
-    return TRUE;
-}
-
-int _impl_vec_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, void *tmp)
-{
-    if (!IS_VALID_VEC(vec_ptr) || !cmpfn || !tmp)
-    {
-        return FALSE;
-    }
-
-    _vec_sort(vec_ptr, cmpfn, tmp);
-    return TRUE;
-}
-
-int _impl_vec_push(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val)
-{
-    if (!IS_VALID_VEC(vec_ptr) || !val)
-    {
-        return FALSE;
-    }
-
-    return _vec_insert(vec_ptr, vec_ptr->size, (const unsigned char *)val, 1);
-}
-
-int _impl_vec_pusharr(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, unsigned int len)
-{
-    if (!IS_VALID_VEC(vec_ptr) || !val)
-    {
-        return FALSE;
-    }
-
-    return _vec_insert(vec_ptr, vec_ptr->size, (const unsigned char *)val, len);
-}
-
-int _impl_vec_pop(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *out)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return FALSE;
-    }
-
-    return _vec_remove(vec_ptr, vec_ptr->size - 1, 1, out);
-}
-
-int _impl_vec_poparr(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int len, void *out)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return FALSE;
-    }
-
-    return _vec_remove(vec_ptr, vec_ptr->size - 1, len, out);
-}
-
-int _impl_vec_erase(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, unsigned int len, void *out)
-{
-    if (!IS_VALID_VEC(vec_ptr))
-    {
-        return FALSE;
-    }
-
-    return _vec_remove(vec_ptr, idx, len, out);
-}
-
-int _impl_vec_insert(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, unsigned int idx, unsigned int len)
-{
-    if (!IS_VALID_VEC(vec_ptr) || !val)
-    {
-        return FALSE;
-    }
-
-    return _vec_insert(vec_ptr, idx, (const unsigned char *)val, len);
-}
-
-void _impl_vec_clear(_IMPL_VEC_STRUCT_NAME *vec_ptr)
-{
-    if (IS_VALID_VEC(vec_ptr))
-    {
-        /* Save the type size before the memset call below */
-        unsigned int t_size = vec_ptr->_t_size;
-
-        if (vec_ptr->_mem)
-        {
-            free(vec_ptr->_mem);
-        }
-
-        /* Clear the struct and restore the type size to allow reuse without calling vec_init */
-        memset(vec_ptr, 0, sizeof(_IMPL_VEC_STRUCT_NAME));
-        vec_ptr->_t_size = t_size;
-    }
-}
-
-#ifdef __cplusplus
-} /* extern "C" { */
-#endif /* __cplusplus */
+/**
+ * @file    cvec.c
+ * @author  Isaac Garzon
+ * @since   24/02/2015
+ *
+ * @section DESCRIPTION
+ *
+ *  A generic vector implementation in ANSI C.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "cvec.h"
+
+/* When CVEC_POW2_CAPACITY is defined the capacity is always kept at a power of two,
+ * which allows wrapping indices around the ring with a mask instead of a division */
+#ifdef CVEC_POW2_CAPACITY
+#   define VEC_DEFAULT_CAPACITY     8
+#   define VEC_ROUND_CAPACITY(cap)  _vec_ceil_pow2(cap)
+#else
+#   define VEC_DEFAULT_CAPACITY     5
+#   define VEC_ROUND_CAPACITY(cap)  (cap)
+#endif
+
+#define VEC_WRAP(idx, max)      _impl_vec_wrap(idx, max)
+#define VEC_SCRATCH_SIZE        512
+#define VEC_MIN_RUN             32
+#define VEC_IDX(idx, max)       VEC_WRAP((idx) + (max), max)
+#define VEC_BYTES(vec, count)   ((size_t)(count) * (vec)->_t_size)
+#define VEC_GET(vec, idx)       (&(vec)->_mem[VEC_BYTES(vec, VEC_WRAP((vec)->start + (idx), (vec)->capacity))])
+#define IS_VALID_VEC(vec) \
+    ((vec) && ((vec)->_t_size) && \
+     ((!(vec)->capacity && !(vec)->_mem) || \
+      ((vec)->size <= (vec)->capacity && (vec)->start < (vec)->capacity)))
+
+/* When CVEC_STATS is defined every vec counts the work of its memory management, and the
+ * counts are added to the process-wide counters as well. Otherwise the counting compiles
+ * to nothing. The process-wide counters are updated atomically if the compiler allows it */
+#ifdef CVEC_STATS
+#   if defined(__GNUC__)
+#       define VEC_GLOBAL_ADD(field, n) ((void)__atomic_fetch_add(&_vec_global_stats.field, n, __ATOMIC_RELAXED))
+#       define VEC_GLOBAL_LOAD(field)   __atomic_load_n(&_vec_global_stats.field, __ATOMIC_RELAXED)
+#   else
+#       define VEC_GLOBAL_ADD(field, n) ((void)(_vec_global_stats.field += (n)))
+#       define VEC_GLOBAL_LOAD(field)   (_vec_global_stats.field)
+#   endif
+#   define VEC_STATS_ADD(vec, field, n)         ((vec)->_stats.field += (n), VEC_GLOBAL_ADD(field, n))
+#   define VEC_STATS_INSERT(vec, idx, len)      _vec_stats_insert(vec, idx, len)
+#else
+#   define VEC_STATS_ADD(vec, field, n)         ((void)0)
+#   define VEC_STATS_INSERT(vec, idx, len)      ((void)0)
+#endif /* CVEC_STATS */
+
+_impl_vec_def_struct(unsigned char, _IMPL_VEC_STRUCT_NAME);
+
+#ifdef CVEC_STATS
+static vec_statistics _vec_global_stats;
+#endif /* CVEC_STATS */
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#ifdef CVEC_POW2_CAPACITY
+static vec_size_t _vec_ceil_pow2(vec_size_t n)
+{
+    vec_size_t pow2 = 1;
+
+    while (pow2 < n)
+    {
+        /* Avoid integer overflow */
+        if (!(pow2 << 1))
+        {
+            return 0;
+        }
+
+        pow2 <<= 1;
+    }
+
+    return pow2;
+}
+#endif /* CVEC_POW2_CAPACITY */
+
+#ifdef CVEC_STATS
+static void _vec_stats_insert(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len)
+{
+    vec_size_t size = vec_ptr->size - len, start = vec_ptr->start, peak = 0;
+
+    /* Find where the elements started before the insertion. It regressed the start only
+     * if the elements before idx were the ones that moved */
+    if (size && (idx < size - idx))
+    {
+        start = VEC_WRAP(start + len, vec_ptr->capacity);
+    }
+
+    /* Count a wrap if the elements circulate beyond the buffer end only since the insertion */
+    if ((size <= vec_ptr->capacity - start) && (vec_ptr->size > vec_ptr->capacity - vec_ptr->start))
+    {
+        VEC_STATS_ADD(vec_ptr, wraps, 1);
+    }
+
+    if (vec_ptr->size > vec_ptr->_stats.high_water)
+    {
+        vec_ptr->_stats.high_water = vec_ptr->size;
+
+#if defined(__GNUC__)
+        peak = __atomic_load_n(&_vec_global_stats.high_water, __ATOMIC_RELAXED);
+        while ((peak < vec_ptr->size) &&
+               !__atomic_compare_exchange_n(&_vec_global_stats.high_water, &peak, vec_ptr->size, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+        peak = _vec_global_stats.high_water;
+        _vec_global_stats.high_water = (peak < vec_ptr->size ? vec_ptr->size : peak);
+#endif
+    }
+}
+#endif /* CVEC_STATS */
+
+static void* _vec_mem_alloc(_IMPL_VEC_STRUCT_NAME *vec_ptr, size_t size)
+{
+    void *mem = (vec_ptr->_alloc ? vec_ptr->_alloc->alloc_fn(vec_ptr->_alloc->ctx, size) : malloc(size));
+
+    if (mem)
+    {
+        VEC_STATS_ADD(vec_ptr, allocs, 1);
+    }
+
+    return mem;
+}
+
+static void* _vec_mem_realloc(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *ptr, size_t old_size, size_t new_size)
+{
+    /* Allocators are never asked to resize a NULL pointer */
+    if (!ptr)
+    {
+        return _vec_mem_alloc(vec_ptr, new_size);
+    }
+
+    if (vec_ptr->_alloc)
+    {
+        ptr = vec_ptr->_alloc->realloc_fn(vec_ptr->_alloc->ctx, ptr, old_size, new_size);
+    }
+    else
+    {
+        ptr = realloc(ptr, new_size);
+    }
+
+    if (ptr)
+    {
+        VEC_STATS_ADD(vec_ptr, reallocs, 1);
+    }
+
+    return ptr;
+}
+
+static void _vec_mem_free(const _IMPL_VEC_STRUCT_NAME *vec_ptr, void *ptr, size_t size)
+{
+    if (vec_ptr->_alloc)
+    {
+        vec_ptr->_alloc->free_fn(vec_ptr->_alloc->ctx, ptr, size);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+/* Temporary buffers are never written to the file of a file-backed allocator. They aren't
+ * buffers of the vec, so they aren't counted in its statistics either */
+void* _impl_vec_scratch_alloc(_IMPL_VEC_STRUCT_NAME *vec_ptr, size_t size)
+{
+    if ((vec_ptr->_alloc) && (!vec_ptr->_alloc->file_backed))
+    {
+        return vec_ptr->_alloc->alloc_fn(vec_ptr->_alloc->ctx, size);
+    }
+
+    return malloc(size);
+}
+
+void _impl_vec_scratch_free(const _IMPL_VEC_STRUCT_NAME *vec_ptr, void *ptr, size_t size)
+{
+    if ((vec_ptr->_alloc) && (!vec_ptr->_alloc->file_backed))
+    {
+        vec_ptr->_alloc->free_fn(vec_ptr->_alloc->ctx, ptr, size);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+static vec_size_t _vec_round_capacity(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t capacity)
+{
+    const vec_growth_policy *policy = vec_ptr->_growth;
+
+    /* Round the byte size of the allocation up to the granularity of the policy */
+    if (policy && policy->granularity > 1)
+    {
+        size_t size = VEC_BYTES(vec_ptr, capacity);
+        size_t rounded = size + (policy->granularity - size % policy->granularity) % policy->granularity;
+        vec_size_t rounded_capacity = (vec_size_t)(rounded / vec_ptr->_t_size);
+
+        /* Avoid integer overflow */
+        if ((size / vec_ptr->_t_size != capacity) || (rounded < size) || (rounded_capacity < capacity))
+        {
+            return 0;
+        }
+
+        capacity = rounded_capacity;
+    }
+
+    /* Round the capacity up if the capacity mode requires it */
+    return VEC_ROUND_CAPACITY(capacity);
+}
+
+static vec_size_t _vec_growth(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len)
+{
+    const vec_growth_policy *policy = vec_ptr->_growth;
+    vec_size_t addition;
+
+    if (!vec_ptr->capacity)
+    {
+        addition = ((policy && policy->min_capacity) ? policy->min_capacity : VEC_DEFAULT_CAPACITY);
+    }
+    else if (policy)
+    {
+        vec_size_t factor = policy->factor_num - policy->factor_den;
+
+        /* Grow by capacity * (factor_num - factor_den) / factor_den without overflowing */
+        addition = vec_ptr->capacity / policy->factor_den * factor +
+                   vec_ptr->capacity % policy->factor_den * factor / policy->factor_den;
+    }
+    else
+    {
+        addition = vec_ptr->capacity;
+    }
+
+    if (!addition)
+    {
+        addition = 1;
+    }
+
+    /* Make sure we have enough to store len elements */
+    while (addition < len)
+    {
+        /* Avoid integer overflow */
+        if (!(addition << 1))
+        {
+            addition = len;
+            break;
+        }
+
+        addition <<= 1;
+    }
+
+    /* Limit the growth step unless more is needed to store len elements */
+    if (policy && policy->max_step && (addition > policy->max_step))
+    {
+        addition = (policy->max_step > len ? policy->max_step : len);
+    }
+
+    return addition;
+}
+
+static void _vec_swap_blocks(unsigned char *first, unsigned char *second, size_t size)
+{
+    unsigned char scratch[VEC_SCRATCH_SIZE];
+
+    /* Swap the blocks through the scratch buffer one chunk at a time */
+    while (size)
+    {
+        size_t chunk = (size < sizeof(scratch) ? size : sizeof(scratch));
+
+        memcpy(scratch, first, chunk);
+        memcpy(first, second, chunk);
+        memcpy(second, scratch, chunk);
+
+        first += chunk, second += chunk, size -= chunk;
+    }
+}
+
+static void _vec_rotate(unsigned char *mem, size_t left, size_t right)
+{
+    unsigned char scratch[VEC_SCRATCH_SIZE];
+
+    /* Swap the order of the left block and the right block that follows it. Each round swaps
+     * the shorter block with the part of the longer block that is furthest from it, which puts
+     * the shorter block in its final place and leaves a smaller rotation to be done (Gries-Mills).
+     * Once the shorter block fits in the scratch buffer, finish with a single memmove */
+    while (left && right)
+    {
+        if (left <= sizeof(scratch))
+        {
+            memcpy(scratch, mem, left);
+            memmove(mem, mem + left, right);
+            memcpy(mem + right, scratch, left);
+            break;
+        }
+
+        if (right <= sizeof(scratch))
+        {
+            memcpy(scratch, mem + left, right);
+            memmove(mem + right, mem, left);
+            memcpy(mem, scratch, right);
+            break;
+        }
+
+        if (left <= right)
+        {
+            _vec_swap_blocks(mem, mem + right, left);
+            right -= left;
+        }
+        else
+        {
+            _vec_swap_blocks(mem, mem + left, right);
+            mem += right;
+            left -= right;
+        }
+    }
+}
+
+static void _vec_align(_IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    /* Check if we actually need to align anything */
+    if (vec_ptr->size > vec_ptr->capacity - vec_ptr->start)
+    {
+        vec_size_t head = vec_ptr->capacity - vec_ptr->start;
+        vec_size_t tail = vec_ptr->size - head;
+
+        VEC_STATS_ADD(vec_ptr, rotations, 1);
+
+        /* Check if the free space is big enough to hold the items at the end of the buffer.
+         * If so, make room for them by moving the circulated items forward, and copy them to
+         * the beginning of the buffer. Otherwise, move the items at the end of the buffer to
+         * right after the circulated items and swap the order of the two blocks */
+        if (vec_ptr->capacity - vec_ptr->size >= head)
+        {
+            memmove(&vec_ptr->_mem[VEC_BYTES(vec_ptr, head)], vec_ptr->_mem, VEC_BYTES(vec_ptr, tail));
+            memcpy(vec_ptr->_mem, &vec_ptr->_mem[VEC_BYTES(vec_ptr, vec_ptr->start)], VEC_BYTES(vec_ptr, head));
+            VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, vec_ptr->size));
+        }
+        else
+        {
+            memmove(&vec_ptr->_mem[VEC_BYTES(vec_ptr, tail)], &vec_ptr->_mem[VEC_BYTES(vec_ptr, vec_ptr->start)], VEC_BYTES(vec_ptr, head));
+            _vec_rotate(vec_ptr->_mem, VEC_BYTES(vec_ptr, tail), VEC_BYTES(vec_ptr, head));
+            VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, vec_ptr->size + head));
+        }
+
+        vec_ptr->start = 0;
+    }
+}
+
+static void _vec_swap(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t first, vec_size_t second, void *tmp)
+{
+    memcpy(tmp, VEC_GET(vec_ptr, first), vec_ptr->_t_size);
+    memcpy(VEC_GET(vec_ptr, first), VEC_GET(vec_ptr, second), vec_ptr->_t_size);
+    memcpy(VEC_GET(vec_ptr, second), tmp, vec_ptr->_t_size);
+}
+
+static void _vec_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    /* Check if we actually need to sort anything */
+    if (vec_ptr->size)
+    {
+        /* Align the buffer so we can pass it to qsort */
+        _vec_align(vec_ptr);
+        qsort(VEC_GET(vec_ptr, 0), vec_ptr->size, vec_ptr->_t_size, cmpfn);
+    }
+}
+
+/* The stable sort helpers work on an aligned array of elements of t_size bytes each */
+#define VEC_ELEM(base, idx, t_size) ((base) + (size_t)(idx) * (t_size))
+
+static vec_size_t _vec_upper_bound(unsigned char *base, vec_size_t lo, vec_size_t hi, size_t t_size, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    /* Find the first element in [lo, hi) that is greater than val */
+    while (lo < hi)
+    {
+        vec_size_t mid = lo + ((hi - lo) >> 1);
+
+        if (cmpfn(val, VEC_ELEM(base, mid, t_size)) < 0)
+        {
+            hi = mid;
+        }
+        else
+        {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+static vec_size_t _vec_lower_bound(unsigned char *base, vec_size_t lo, vec_size_t hi, size_t t_size, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    /* Find the first element in [lo, hi) that is not less than val */
+    while (lo < hi)
+    {
+        vec_size_t mid = lo + ((hi - lo) >> 1);
+
+        if (cmpfn(VEC_ELEM(base, mid, t_size), val) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static vec_size_t _vec_ascending_run(unsigned char *base, vec_size_t lo, vec_size_t count, size_t t_size, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    for (++lo; lo < count && cmpfn(VEC_ELEM(base, lo - 1, t_size), VEC_ELEM(base, lo, t_size)) <= 0; ++lo);
+    return lo;
+}
+
+static vec_size_t _vec_natural_run(unsigned char *base, vec_size_t lo, vec_size_t count, size_t t_size, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned char *tmp)
+{
+    vec_size_t hi = lo + 1, i = 0;
+
+    if (hi >= count || cmpfn(VEC_ELEM(base, lo, t_size), VEC_ELEM(base, hi, t_size)) <= 0)
+    {
+        return _vec_ascending_run(base, lo, count, t_size, cmpfn);
+    }
+
+    /* Only strictly descending runs are reversed, since reversing equal elements isn't stable */
+    for (++hi; hi < count && cmpfn(VEC_ELEM(base, hi - 1, t_size), VEC_ELEM(base, hi, t_size)) > 0; ++hi);
+
+    for (i = 0; i < (hi - lo) >> 1; ++i)
+    {
+        memcpy(tmp, VEC_ELEM(base, lo + i, t_size), t_size);
+        memcpy(VEC_ELEM(base, lo + i, t_size), VEC_ELEM(base, hi - i - 1, t_size), t_size);
+        memcpy(VEC_ELEM(base, hi - i - 1, t_size), tmp, t_size);
+    }
+
+    return hi;
+}
+
+static void _vec_insertion_sort(unsigned char *base, vec_size_t lo, vec_size_t sorted, vec_size_t hi, size_t t_size, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned char *tmp)
+{
+    /* Insert the elements of [sorted, hi) into the sorted range [lo, sorted) after the elements equal to them */
+    for (; sorted < hi; ++sorted)
+    {
+        vec_size_t pos = _vec_upper_bound(base, lo, sorted, t_size, VEC_ELEM(base, sorted, t_size), cmpfn);
+
+        if (pos < sorted)
+        {
+            memcpy(tmp, VEC_ELEM(base, sorted, t_size), t_size);
+            memmove(VEC_ELEM(base, pos + 1, t_size), VEC_ELEM(base, pos, t_size), (size_t)(sorted - pos) * t_size);
+            memcpy(VEC_ELEM(base, pos, t_size), tmp, t_size);
+        }
+    }
+}
+
+static void _vec_merge(unsigned char *base, vec_size_t lo, vec_size_t mid, vec_size_t hi, size_t t_size, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned char *buf)
+{
+    vec_size_t i = 0, j = 0, k = 0, len = 0;
+
+    /* Skip the beginning of the left run that is already in place before the right run,
+     * and the end of the right run that is already in place after the left run */
+    lo = _vec_upper_bound(base, lo, mid, t_size, VEC_ELEM(base, mid, t_size), cmpfn);
+    hi = _vec_lower_bound(base, mid, hi, t_size, VEC_ELEM(base, mid - 1, t_size), cmpfn);
+
+    if (lo == mid || mid == hi)
+    {
+        return;
+    }
+
+    /* Move the shorter run aside and merge towards its end of the range. Ties are
+     * always resolved in favor of the left run to keep the sort stable */
+    if (mid - lo <= hi - mid)
+    {
+        len = mid - lo;
+        memcpy(buf, VEC_ELEM(base, lo, t_size), (size_t)len * t_size);
+
+        for (i = 0, j = mid, k = lo; i < len && j < hi; ++k)
+        {
+            if (cmpfn(VEC_ELEM(base, j, t_size), VEC_ELEM(buf, i, t_size)) < 0)
+            {
+                memcpy(VEC_ELEM(base, k, t_size), VEC_ELEM(base, j++, t_size), t_size);
+            }
+            else
+            {
+                memcpy(VEC_ELEM(base, k, t_size), VEC_ELEM(buf, i++, t_size), t_size);
+            }
+        }
+
+        memcpy(VEC_ELEM(base, k, t_size), VEC_ELEM(buf, i, t_size), (size_t)(len - i) * t_size);
+    }
+    else
+    {
+        len = hi - mid;
+        memcpy(buf, VEC_ELEM(base, mid, t_size), (size_t)len * t_size);
+
+        for (i = len, j = mid, k = hi; i > 0 && j > lo; )
+        {
+            if (cmpfn(VEC_ELEM(buf, i - 1, t_size), VEC_ELEM(base, j - 1, t_size)) < 0)
+            {
+                memcpy(VEC_ELEM(base, --k, t_size), VEC_ELEM(base, --j, t_size), t_size);
+            }
+            else
+            {
+                memcpy(VEC_ELEM(base, --k, t_size), VEC_ELEM(buf, --i, t_size), t_size);
+            }
+        }
+
+        memcpy(VEC_ELEM(base, lo, t_size), buf, (size_t)i * t_size);
+    }
+}
+
+static void _vec_stable_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned char *buf)
+{
+    unsigned char *base = NULL;
+    vec_size_t lo = 0, mid = 0, hi = 0, count = vec_ptr->size;
+    size_t t_size = vec_ptr->_t_size;
+
+    /* Align the buffer so the runs are contiguous */
+    _vec_align(vec_ptr);
+    base = VEC_GET(vec_ptr, 0);
+
+    /* Find the natural runs and extend the short ones with insertion sort so random
+     * input doesn't end up merging lots of tiny runs */
+    for (lo = 0; lo < count; lo = hi)
+    {
+        hi = _vec_natural_run(base, lo, count, t_size, cmpfn, buf);
+
+        if (hi - lo < VEC_MIN_RUN && hi < count)
+        {
+            vec_size_t end = (count - lo < VEC_MIN_RUN ? count : lo + VEC_MIN_RUN);
+
+            _vec_insertion_sort(base, lo, hi, end, t_size, cmpfn, buf);
+            hi = end;
+        }
+    }
+
+    /* Merge adjacent pairs of runs until a single run is left. Already sorted input takes
+     * a single pass over the elements to find out there's nothing to merge */
+    while ((mid = _vec_ascending_run(base, 0, count, t_size, cmpfn)) < count)
+    {
+        for (lo = 0; mid < count; lo = hi)
+        {
+            hi = _vec_ascending_run(base, mid, count, t_size, cmpfn);
+            _vec_merge(base, lo, mid, hi, t_size, cmpfn, buf);
+
+            if (hi >= count)
+            {
+                break;
+            }
+
+            mid = _vec_ascending_run(base, hi, count, t_size, cmpfn);
+        }
+    }
+}
+
+static vec_size_t _vec_bound(const _IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn, int upper)
+{
+    vec_size_t lo = 0, hi = vec_ptr->size;
+
+    /* Search the ring in logical order, so there's no need to align it first. Find the first
+     * element that is greater than val for the upper bound, or not less than it otherwise */
+    while (lo < hi)
+    {
+        vec_size_t mid = lo + ((hi - lo) >> 1);
+        const void *elem = VEC_GET(vec_ptr, mid);
+
+        if (upper ? (cmpfn(val, elem) >= 0) : (cmpfn(elem, val) < 0))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+static int _vec_reserve(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t capacity)
+{
+    /* Check if we need to do anything */
+    if (capacity > vec_ptr->capacity)
+    {
+        unsigned char *new_mem;
+        vec_size_t circular_items = 0;
+        int use_malloc;
+        size_t size;
+
+        /* Check if there are items that circulated beyond the buffer end */
+        if (vec_ptr->size > vec_ptr->capacity - vec_ptr->start)
+        {
+            circular_items = vec_ptr->size - (vec_ptr->capacity - vec_ptr->start);
+        }
+
+        /* Round the capacity up according to the growth policy and the capacity mode */
+        capacity = _vec_round_capacity(vec_ptr, capacity);
+        use_malloc = (circular_items > capacity - vec_ptr->capacity);
+        size = VEC_BYTES(vec_ptr, capacity);
+
+        /* Avoid integer overflow */
+        if ((!capacity) || (size / vec_ptr->_t_size != capacity))
+        {
+            return FALSE;
+        }
+
+        /* Naive optimization: if we have items that circulated to the beginning of vec_ptr->_mem,
+         * check if we can copy them back to the end in a single memcpy call. If so, use realloc
+         * to minimize allocation overhead. Otherwise, the amount of copy needed already creates
+         * a huge overhead. Simply use malloc and copy */
+        if (use_malloc)
+        {
+            new_mem = (unsigned char *)_vec_mem_alloc(vec_ptr, size);
+        }
+        else
+        {
+            new_mem = (unsigned char *)_vec_mem_realloc(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity), size);
+        }
+
+        /* Check if allocation succeeded */
+        if (!new_mem)
+        {
+            return FALSE;
+        }
+
+        /* Check if there are items that circulated beyond the buffer end */
+        if (circular_items)
+        {
+            if (!use_malloc)
+            {
+                /* Move the circulated items from the beginning of the buffer to the newly
+                 * allocated space right after the old buffer end */
+                memcpy(new_mem + VEC_BYTES(vec_ptr, vec_ptr->capacity), new_mem, VEC_BYTES(vec_ptr, circular_items));
+                VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, circular_items));
+            }
+            else
+            {
+                size_t bytes_at_end = VEC_BYTES(vec_ptr, vec_ptr->capacity - vec_ptr->start);
+
+                /* We need to copy the items from vec_ptr->start until the end of the vec_ptr->_mem and
+                 * then copy the rest of the items from the beginning of vec_ptr->_mem */
+                memcpy(new_mem, VEC_GET(vec_ptr, 0), bytes_at_end);
+                memcpy(new_mem + bytes_at_end, vec_ptr->_mem, VEC_BYTES(vec_ptr, circular_items));
+                VEC_STATS_ADD(vec_ptr, copies, 1);
+                VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, vec_ptr->size));
+
+                /* We're now at the beginning of the memory block */
+                vec_ptr->start = 0;
+
+                /* Free the old memory */
+                _vec_mem_free(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity));
+            }
+        }
+
+        /* Set the new values */
+        vec_ptr->_mem = new_mem;
+        vec_ptr->capacity = capacity;
+    }
+
+    return TRUE;
+}
+
+static void _vec_move(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t dst, vec_size_t src, vec_size_t len)
+{
+    size_t tsize = vec_ptr->_t_size;
+    vec_size_t capacity = vec_ptr->capacity;
+
+    VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, len));
+
+    /* Move the elements in runs that don't cross the buffer end neither in the source nor in the
+     * destination, which means at most three memmove calls. When moving forward the runs are
+     * moved starting from the end so the source isn't overwritten before it's moved */
+    if (dst < src)
+    {
+        while (len)
+        {
+            vec_size_t from = VEC_WRAP(vec_ptr->start + src, capacity);
+            vec_size_t to = VEC_WRAP(vec_ptr->start + dst, capacity);
+            vec_size_t run = len;
+
+            if (run > capacity - from)
+            {
+                run = capacity - from;
+            }
+
+            if (run > capacity - to)
+            {
+                run = capacity - to;
+            }
+
+            memmove(&vec_ptr->_mem[to * tsize], &vec_ptr->_mem[from * tsize], run * tsize);
+            src += run, dst += run, len -= run;
+        }
+    }
+    else if (dst > src)
+    {
+        while (len)
+        {
+            vec_size_t from_end = VEC_WRAP(vec_ptr->start + src + len - 1, capacity) + 1;
+            vec_size_t to_end = VEC_WRAP(vec_ptr->start + dst + len - 1, capacity) + 1;
+            vec_size_t run = len;
+
+            if (run > from_end)
+            {
+                run = from_end;
+            }
+
+            if (run > to_end)
+            {
+                run = to_end;
+            }
+
+            memmove(&vec_ptr->_mem[(to_end - run) * tsize], &vec_ptr->_mem[(from_end - run) * tsize], run * tsize);
+            len -= run;
+        }
+    }
+}
+
+static void _vec_copy_in(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, const unsigned char *val, vec_size_t len)
+{
+    vec_size_t pos = VEC_WRAP(vec_ptr->start + idx, vec_ptr->capacity);
+    vec_size_t run = vec_ptr->capacity - pos;
+
+    if (run > len)
+    {
+        run = len;
+    }
+
+    /* Copy the elements up to the buffer end and then the rest to its beginning */
+    memcpy(&vec_ptr->_mem[VEC_BYTES(vec_ptr, pos)], val, VEC_BYTES(vec_ptr, run));
+    memcpy(vec_ptr->_mem, val + VEC_BYTES(vec_ptr, run), VEC_BYTES(vec_ptr, len - run));
+}
+
+static void _vec_copy_out(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, unsigned char *out, vec_size_t len)
+{
+    vec_size_t pos = VEC_WRAP(vec_ptr->start + idx, vec_ptr->capacity);
+    vec_size_t run = vec_ptr->capacity - pos;
+
+    if (run > len)
+    {
+        run = len;
+    }
+
+    /* Copy the elements up to the buffer end and then the rest from its beginning */
+    memcpy(out, &vec_ptr->_mem[VEC_BYTES(vec_ptr, pos)], VEC_BYTES(vec_ptr, run));
+    memcpy(out + VEC_BYTES(vec_ptr, run), vec_ptr->_mem, VEC_BYTES(vec_ptr, len - run));
+}
+
+static int _vec_shrink(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t capacity)
+{
+    unsigned char *new_mem;
+    size_t size;
+
+    /* An empty vec simply gives back all of its memory */
+    if (!capacity)
+    {
+        if (vec_ptr->_mem)
+        {
+            _vec_mem_free(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity));
+        }
+
+        vec_ptr->_mem = NULL;
+        vec_ptr->start = 0;
+        vec_ptr->capacity = 0;
+
+        return TRUE;
+    }
+
+    /* Round the capacity up according to the growth policy and the capacity mode,
+     * and check if we need to do anything */
+    capacity = _vec_round_capacity(vec_ptr, capacity);
+
+    if ((!capacity) || (capacity >= vec_ptr->capacity))
+    {
+        return TRUE;
+    }
+
+    size = VEC_BYTES(vec_ptr, capacity);
+
+    /* If the items circulated beyond the buffer end, they can't be moved to their place
+     * in the smaller buffer in a single call. Simply allocate a new buffer and copy them */
+    if (vec_ptr->size > vec_ptr->capacity - vec_ptr->start)
+    {
+        new_mem = (unsigned char *)_vec_mem_alloc(vec_ptr, size);
+
+        if (!new_mem)
+        {
+            return FALSE;
+        }
+
+        _vec_copy_out(vec_ptr, 0, new_mem, vec_ptr->size);
+        _vec_mem_free(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity));
+        VEC_STATS_ADD(vec_ptr, copies, 1);
+        VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, vec_ptr->size));
+
+        /* We're now at the beginning of the memory block */
+        vec_ptr->start = 0;
+    }
+    else
+    {
+        /* Move the items to the beginning of the buffer if they don't fit before the new end */
+        if (vec_ptr->start + vec_ptr->size > capacity)
+        {
+            memmove(vec_ptr->_mem, VEC_GET(vec_ptr, 0), VEC_BYTES(vec_ptr, vec_ptr->size));
+            VEC_STATS_ADD(vec_ptr, bytes_moved, VEC_BYTES(vec_ptr, vec_ptr->size));
+            vec_ptr->start = 0;
+        }
+
+        new_mem = (unsigned char *)_vec_mem_realloc(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity), size);
+
+        if (!new_mem)
+        {
+            return FALSE;
+        }
+    }
+
+    /* Set the new values */
+    vec_ptr->_mem = new_mem;
+    vec_ptr->capacity = capacity;
+
+    return TRUE;
+}
+
+static int _vec_grow(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len)
+{
+    /* Check if we need to reserve more memory */
+    if (vec_ptr->size + len > vec_ptr->capacity)
+    {
+        vec_size_t addition = _vec_growth(vec_ptr, len);
+
+        /* Avoid integer overflow */
+        if (vec_ptr->capacity + addition < vec_ptr->capacity)
+        {
+            addition = len;
+        }
+
+        /* Try to reserve place to fit at least len elements */
+        while (!_vec_reserve(vec_ptr, vec_ptr->capacity + addition))
+        {
+            /* Divide by two and try again unless reserve failed even for exactly len elemnts more */
+            if ((addition >>= 1) < len)
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+static int _vec_insert(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, const unsigned char *val, vec_size_t len)
+{
+    /* Don't allow adding elements in arbitrary place that is beyond vec_ptr->size
+     * and avoid integer overflow */
+    if ((idx > vec_ptr->size) || (vec_ptr->size + len < vec_ptr->size))
+    {
+        return FALSE;
+    }
+
+    /* Check if we actually need to do anything */
+    if (len)
+    {
+        /* Check if we need to reserve more memory */
+        if (!_vec_grow(vec_ptr, len))
+        {
+            return FALSE;
+        }
+
+        /* Perform all sorts of crazy calculations only if we already have some elements and
+         * we might need to move them around. Otherwise this is the first insertion, so simply
+         * put it in idx 0 and be done with it */
+        if (vec_ptr->size > 0)
+        {
+            /* Move whichever side of idx is shorter. If it's the beginning of vec_ptr, regress
+             * the start pointer to create the free slots and move the elements before idx into
+             * them. If idx is 0, this is simply a pointer regression */
+            if (idx < vec_ptr->size - idx)
+            {
+                vec_ptr->start = VEC_IDX(vec_ptr->start - len, vec_ptr->capacity);
+                _vec_move(vec_ptr, 0, len, idx);
+            }
+            else if (idx < vec_ptr->size)
+            {
+                /* Move the elements from idx until the end of vec_ptr len slots forward */
+                _vec_move(vec_ptr, idx + len, idx, vec_ptr->size - idx);
+            }
+        }
+
+        vec_ptr->size += len;
+        VEC_STATS_INSERT(vec_ptr, idx, len);
+
+        /* Copy len elements from val into the free slots */
+        _vec_copy_in(vec_ptr, idx, val, len);
+    }
+
+    return TRUE;
+}
+
+static int _vec_remove(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len, void *opt_out_val)
+{
+    /* Make sure that the index is reachable */
+    if ((len > vec_ptr->size) || (vec_ptr->size - len < idx))
+    {
+        return FALSE;
+    }
+
+    /* Check if we actually need to do anything */
+    if (len)
+    {
+        /* Check if we need to copy the value that is being removed */
+        if (opt_out_val)
+        {
+            _vec_copy_out(vec_ptr, idx, (unsigned char *)opt_out_val, len);
+        }
+
+        vec_ptr->size -= len;
+
+        /* Check if we need to shift elements around because of the removal */
+        if (vec_ptr->size)
+        {
+            /* Move whichever side of the removed elements is shorter. If it's the beginning of
+             * vec_ptr, move the elements before idx len slots forward and advance the start pointer
+             * past the free slots. If idx is 0, this is simply a pointer advancement */
+            if (idx < vec_ptr->size - idx)
+            {
+                _vec_move(vec_ptr, len, 0, idx);
+                vec_ptr->start = VEC_IDX(vec_ptr->start + len, vec_ptr->capacity);
+            }
+            else if (idx < vec_ptr->size)
+            {
+                /* Move the elements after the removed ones until the end of vec_ptr len slots back */
+                _vec_move(vec_ptr, idx, idx + len, vec_ptr->size - idx);
+            }
+        }
+
+        /* Check if the growth policy requires shrinking the vec. Shrink to twice the size
+         * so that it takes either halving the size or doubling it to reallocate again */
+        if ((vec_ptr->_growth) && (vec_ptr->_growth->shrink_divisor) &&
+            (vec_ptr->size < vec_ptr->capacity / vec_ptr->_growth->shrink_divisor))
+        {
+            vec_size_t capacity = vec_ptr->size << 1;
+
+            if (capacity < vec_ptr->_growth->min_capacity)
+            {
+                capacity = vec_ptr->_growth->min_capacity;
+            }
+
+            /* Failing to shrink isn't an error, as the items were already removed */
+            (void)_vec_shrink(vec_ptr, (capacity ? capacity : VEC_DEFAULT_CAPACITY));
+        }
+    }
+
+    return TRUE;
+}
+
+int _impl_vec_init(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size)
+{
+    if ((!vec_ptr) || (!t_size))
+    {
+        return FALSE;
+    }
+
+    memset(vec_ptr, 0, sizeof(_IMPL_VEC_STRUCT_NAME));
+    vec_ptr->_t_size = t_size;
+
+    return TRUE;
+}
+
+int _impl_vec_init_alloc(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, const vec_allocator *alloc)
+{
+    if ((!alloc) || (!alloc->alloc_fn) || (!alloc->realloc_fn) || (!alloc->free_fn))
+    {
+        return FALSE;
+    }
+
+    if (!_impl_vec_init(vec_ptr, t_size))
+    {
+        return FALSE;
+    }
+
+    vec_ptr->_alloc = alloc;
+    return TRUE;
+}
+
+int _impl_vec_reserve(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t capacity)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    return _vec_reserve(vec_ptr, capacity);
+}
+
+int _impl_vec_shrink_to_fit(_IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    return _vec_shrink(vec_ptr, vec_ptr->size);
+}
+
+int _impl_vec_set_growth(_IMPL_VEC_STRUCT_NAME *vec_ptr, const vec_growth_policy *policy)
+{
+    if (!IS_VALID_VEC(vec_ptr) ||
+        (policy && ((!policy->factor_den) || (policy->factor_num <= policy->factor_den) ||
+                    (policy->shrink_divisor && policy->shrink_divisor <= 2))))
+    {
+        return FALSE;
+    }
+
+    vec_ptr->_growth = policy;
+    return TRUE;
+}
+
+int _impl_vec_grow(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len)
+{
+    /* Avoid integer overflow */
+    if (!IS_VALID_VEC(vec_ptr) || (vec_ptr->size + len < vec_ptr->size))
+    {
+        return FALSE;
+    }
+
+    return _vec_grow(vec_ptr, len);
+}
+
+void _impl_vec_advance(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len)
+{
+    vec_ptr->size += len;
+    VEC_STATS_INSERT(vec_ptr, vec_ptr->size - len, len);
+}
+
+vec_size_t _impl_vec_size(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return 0;
+    }
+
+    return vec_ptr->size;
+}
+
+vec_size_t _impl_vec_capacity(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return 0;
+    }
+
+    return vec_ptr->capacity;
+}
+
+void* _impl_vec_get(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx)
+{
+    if (!IS_VALID_VEC(vec_ptr) || (idx >= vec_ptr->size))
+    {
+        return NULL;
+    }
+
+    return VEC_GET(vec_ptr, idx);
+}
+
+void* _impl_vec_last(const _IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !vec_ptr->size)
+    {
+        return NULL;
+    }
+
+    return VEC_GET(vec_ptr, vec_ptr->size - 1);
+}
+
+int _impl_vec_assign(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, const void *val)
+{
+    if (!IS_VALID_VEC(vec_ptr) || idx >= vec_ptr->size || !val)
+    {
+        return FALSE;
+    }
+
+    memcpy(VEC_GET(vec_ptr, idx), val, vec_ptr->_t_size);
+    return TRUE;
+}
+
+int _impl_vec_swap(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t first, vec_size_t second, void *tmp)
+{
+    if (!IS_VALID_VEC(vec_ptr) || (first >= vec_ptr->size) || (second >= vec_ptr->size))
+    {
+        return FALSE;
+    }
+
+    /* Check if we actually need to do anything */
+    if (first != second)
+    {
+        _vec_swap(vec_ptr, first, second, tmp);
+    }
+
+    return TRUE;
+}
+
+int _impl_vec_align(_IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    _vec_align(vec_ptr);
+    return TRUE;
+}
+
+void* _impl_vec_data(_IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !vec_ptr->size)
+    {
+        return NULL;
+    }
+
+    _vec_align(vec_ptr);
+    return VEC_GET(vec_ptr, 0);
+}
+
+int _impl_vec_slice(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len, _IMPL_VEC_SPAN_NAME spans[2])
+{
+    if (!IS_VALID_VEC(vec_ptr) || !spans || (len > vec_ptr->size) || (vec_ptr->size - len < idx))
+    {
+        return FALSE;
+    }
+
+    spans[0].data = NULL;
+    spans[0].size = 0;
+    spans[1].data = NULL;
+    spans[1].size = 0;
+
+    if (len)
+    {
+        vec_size_t pos = VEC_WRAP(vec_ptr->start + idx, vec_ptr->capacity);
+
+        /* The range is split in two if it circulates beyond the buffer end */
+        spans[0].data = &vec_ptr->_mem[VEC_BYTES(vec_ptr, pos)];
+        spans[0].size = (len < vec_ptr->capacity - pos ? len : vec_ptr->capacity - pos);
+
+        if (spans[0].size < len)
+        {
+            spans[1].data = vec_ptr->_mem;
+            spans[1].size = len - spans[0].size;
+        }
+    }
+
+    return TRUE;
+}
+
+int _impl_vec_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !cmpfn)
+    {
+        return FALSE;
+    }
+
+    _vec_sort(vec_ptr, cmpfn);
+    return TRUE;
+}
+
+int _impl_vec_stable_sort(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, _IMPL_VEC_STRUCT_NAME *scratch_ptr)
+{
+    /* Merging needs room for the shorter of two runs, and at least one element as temporary storage */
+    vec_size_t scratch_size = 0;
+    unsigned char *buf = NULL;
+
+    if (!IS_VALID_VEC(vec_ptr) || !cmpfn || (scratch_ptr == vec_ptr) ||
+        (scratch_ptr && (!IS_VALID_VEC(scratch_ptr) || (scratch_ptr->_t_size != vec_ptr->_t_size))))
+    {
+        return FALSE;
+    }
+
+    /* Check if we actually need to sort anything */
+    if (vec_ptr->size < 2)
+    {
+        return TRUE;
+    }
+
+    scratch_size = vec_ptr->size >> 1;
+
+    if (scratch_ptr)
+    {
+        /* The elements of the scratch vec are discarded, so there's nothing to copy when it grows */
+        scratch_ptr->start = 0;
+        scratch_ptr->size = 0;
+
+        if (!_vec_reserve(scratch_ptr, scratch_size))
+        {
+            return FALSE;
+        }
+
+        buf = scratch_ptr->_mem;
+    }
+    else if (!(buf = (unsigned char *)_impl_vec_scratch_alloc(vec_ptr, VEC_BYTES(vec_ptr, scratch_size))))
+    {
+        return FALSE;
+    }
+
+    _vec_stable_sort(vec_ptr, cmpfn, buf);
+
+    if (!scratch_ptr)
+    {
+        _impl_vec_scratch_free(vec_ptr, buf, VEC_BYTES(vec_ptr, scratch_size));
+    }
+
+    return TRUE;
+}
+
+vec_size_t _impl_vec_lower_bound(const _IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val || !cmpfn)
+    {
+        return 0;
+    }
+
+    return _vec_bound(vec_ptr, val, cmpfn, FALSE);
+}
+
+vec_size_t _impl_vec_upper_bound(const _IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val || !cmpfn)
+    {
+        return 0;
+    }
+
+    return _vec_bound(vec_ptr, val, cmpfn, TRUE);
+}
+
+int _impl_vec_insert_sorted(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val || !cmpfn)
+    {
+        return FALSE;
+    }
+
+    /* Insert after the equal elements to keep the insertion order among them */
+    return _vec_insert(vec_ptr, _vec_bound(vec_ptr, val, cmpfn, TRUE), (const unsigned char *)val, 1);
+}
+
+int _impl_vec_push(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val)
+    {
+        return FALSE;
+    }
+
+    return _vec_insert(vec_ptr, vec_ptr->size, (const unsigned char *)val, 1);
+}
+
+int _impl_vec_pusharr(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, vec_size_t len)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val)
+    {
+        return FALSE;
+    }
+
+    return _vec_insert(vec_ptr, vec_ptr->size, (const unsigned char *)val, len);
+}
+
+int _impl_vec_extend(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len, _IMPL_VEC_SPAN_NAME spans[2])
+{
+    /* Avoid integer overflow */
+    if (!IS_VALID_VEC(vec_ptr) || !spans || (vec_ptr->size + len < vec_ptr->size))
+    {
+        return FALSE;
+    }
+
+    if (!_vec_grow(vec_ptr, len))
+    {
+        return FALSE;
+    }
+
+    /* The elements are left for the caller to construct, so only the size is advanced */
+    _impl_vec_advance(vec_ptr, len);
+    return _impl_vec_slice(vec_ptr, vec_ptr->size - len, len, spans);
+}
+
+int _impl_vec_pop(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *out)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    return _vec_remove(vec_ptr, vec_ptr->size - 1, 1, out);
+}
+
+int _impl_vec_poparr(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len, void *out)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    return _vec_remove(vec_ptr, vec_ptr->size - len, len, out);
+}
+
+int _impl_vec_erase(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len, void *out)
+{
+    if (!IS_VALID_VEC(vec_ptr))
+    {
+        return FALSE;
+    }
+
+    return _vec_remove(vec_ptr, idx, len, out);
+}
+
+int _impl_vec_insert(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, vec_size_t idx, vec_size_t len)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !val)
+    {
+        return FALSE;
+    }
+
+    return _vec_insert(vec_ptr, idx, (const unsigned char *)val, len);
+}
+
+void _impl_vec_clear(_IMPL_VEC_STRUCT_NAME *vec_ptr)
+{
+    if (IS_VALID_VEC(vec_ptr))
+    {
+        /* Save the type size, the allocator, the growth policy and the counters before the memset call below */
+        vec_size_t t_size = vec_ptr->_t_size;
+        const vec_allocator *alloc = vec_ptr->_alloc;
+        const vec_growth_policy *growth = vec_ptr->_growth;
+#ifdef CVEC_STATS
+        vec_statistics stats = vec_ptr->_stats;
+#endif /* CVEC_STATS */
+
+        if (vec_ptr->_mem)
+        {
+            _vec_mem_free(vec_ptr, vec_ptr->_mem, VEC_BYTES(vec_ptr, vec_ptr->capacity));
+        }
+
+        /* Clear the struct and restore the type size, the allocator, the growth policy and the counters to
+         * allow reuse without calling vec_init */
+        memset(vec_ptr, 0, sizeof(_IMPL_VEC_STRUCT_NAME));
+        vec_ptr->_t_size = t_size;
+        vec_ptr->_alloc = alloc;
+        vec_ptr->_growth = growth;
+#ifdef CVEC_STATS
+        vec_ptr->_stats = stats;
+#endif /* CVEC_STATS */
+    }
+}
+
+#ifdef CVEC_STATS
+int _impl_vec_stats(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_statistics *stats)
+{
+    if (!IS_VALID_VEC(vec_ptr) || !stats)
+    {
+        return FALSE;
+    }
+
+    *stats = vec_ptr->_stats;
+    return TRUE;
+}
+
+void vec_stats_global(vec_statistics *stats)
+{
+    if (stats)
+    {
+        stats->allocs = VEC_GLOBAL_LOAD(allocs);
+        stats->reallocs = VEC_GLOBAL_LOAD(reallocs);
+        stats->copies = VEC_GLOBAL_LOAD(copies);
+        stats->bytes_moved = VEC_GLOBAL_LOAD(bytes_moved);
+        stats->wraps = VEC_GLOBAL_LOAD(wraps);
+        stats->rotations = VEC_GLOBAL_LOAD(rotations);
+        stats->high_water = VEC_GLOBAL_LOAD(high_water);
+    }
+}
+#endif /* CVEC_STATS */
+
+/* A block of an arena. The allocations are carved out of the memory right after it */
+struct _vec_arena_block
+{
+    struct _vec_arena_block *next;
+    size_t size;
+    size_t used;
+};
+
+/* Used to find the strictest fundamental alignment */
+typedef union _vec_arena_align
+{
+    long l;
+    double d;
+    long double ld;
+    void *p;
+    void (*fp)(void);
+} _vec_arena_align;
+
+#define VEC_ARENA_ALIGN(size)       (((size) + sizeof(_vec_arena_align) - 1) & ~(sizeof(_vec_arena_align) - 1))
+#define VEC_ARENA_HEADER_SIZE       VEC_ARENA_ALIGN(sizeof(struct _vec_arena_block))
+#define VEC_ARENA_BLOCK_DATA(block) ((unsigned char *)(block) + VEC_ARENA_HEADER_SIZE)
+
+static int _vec_arena_is_last(const struct _vec_arena_block *block, const void *ptr, size_t size)
+{
+    return (block) && ((const unsigned char *)ptr + VEC_ARENA_ALIGN(size) == VEC_ARENA_BLOCK_DATA(block) + block->used);
+}
+
+static void* _vec_arena_alloc(void *ctx, size_t size)
+{
+    vec_arena *arena = (vec_arena *)ctx;
+    struct _vec_arena_block *block = arena->_blocks;
+    size_t aligned = VEC_ARENA_ALIGN(size);
+
+    /* Avoid integer overflow */
+    if (aligned < size)
+    {
+        return NULL;
+    }
+
+    /* Check if the allocation fits in the current block */
+    if ((!block) || (block->size - block->used < aligned))
+    {
+        size_t block_size = (aligned > arena->_block_size ? aligned : arena->_block_size);
+
+        /* Avoid integer overflow */
+        if (VEC_ARENA_HEADER_SIZE + block_size < block_size)
+        {
+            return NULL;
+        }
+
+        block = (struct _vec_arena_block *)malloc(VEC_ARENA_HEADER_SIZE + block_size);
+
+        if (!block)
+        {
+            return NULL;
+        }
+
+        block->size = block_size;
+        block->used = 0;
+
+        /* Oversized allocations get a block of their own, so keep carving from the current block */
+        if ((aligned > arena->_block_size) && (arena->_blocks))
+        {
+            block->next = arena->_blocks->next;
+            arena->_blocks->next = block;
+            block->used = aligned;
+            return VEC_ARENA_BLOCK_DATA(block);
+        }
+
+        block->next = arena->_blocks;
+        arena->_blocks = block;
+    }
+
+    block->used += aligned;
+    return VEC_ARENA_BLOCK_DATA(block) + block->used - aligned;
+}
+
+static void* _vec_arena_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    vec_arena *arena = (vec_arena *)ctx;
+    struct _vec_arena_block *block = arena->_blocks;
+    void *new_ptr;
+
+    /* If this is the last allocation in the current block, try to resize it in place */
+    if (_vec_arena_is_last(block, ptr, old_size))
+    {
+        size_t offset = (size_t)((unsigned char *)ptr - VEC_ARENA_BLOCK_DATA(block));
+        size_t aligned = VEC_ARENA_ALIGN(new_size);
+
+        if ((aligned >= new_size) && (block->size - offset >= aligned))
+        {
+            block->used = offset + aligned;
+            return ptr;
+        }
+    }
+    else if (new_size <= old_size)
+    {
+        return ptr;
+    }
+
+    new_ptr = _vec_arena_alloc(ctx, new_size);
+
+    if (new_ptr)
+    {
+        memcpy(new_ptr, ptr, (old_size < new_size ? old_size : new_size));
+    }
+
+    return new_ptr;
+}
+
+static void _vec_arena_free(void *ctx, void *ptr, size_t size)
+{
+    vec_arena *arena = (vec_arena *)ctx;
+
+    /* Only the last allocation in the current block can be given back.
+     * Everything else is freed when the arena is released */
+    if (_vec_arena_is_last(arena->_blocks, ptr, size))
+    {
+        arena->_blocks->used -= VEC_ARENA_ALIGN(size);
+    }
+}
+
+int vec_arena_init(vec_arena *arena, size_t block_size)
+{
+    if ((!arena) || (!block_size))
+    {
+        return FALSE;
+    }
+
+    arena->allocator.alloc_fn = _vec_arena_alloc;
+    arena->allocator.realloc_fn = _vec_arena_realloc;
+    arena->allocator.free_fn = _vec_arena_free;
+    arena->allocator.ctx = arena;
+    arena->allocator.file_backed = FALSE;
+    arena->_blocks = NULL;
+    arena->_block_size = VEC_ARENA_ALIGN(block_size);
+
+    return TRUE;
+}
+
+void vec_arena_release(vec_arena *arena)
+{
+    if (arena)
+    {
+        while (arena->_blocks)
+        {
+            struct _vec_arena_block *next = arena->_blocks->next;
+
+            free(arena->_blocks);
+            arena->_blocks = next;
+        }
+    }
+}
+
+static void* _vec_sbo_alloc(void *ctx, size_t size)
+{
+    vec_sbo *sbo = (vec_sbo *)ctx;
+
+    if ((!sbo->_in_use) && (size <= sbo->_size))
+    {
+        sbo->_in_use = TRUE;
+        return sbo->_buf;
+    }
+
+    return malloc(size);
+}
+
+static void* _vec_sbo_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    vec_sbo *sbo = (vec_sbo *)ctx;
+    void *new_ptr;
+
+    if (ptr == sbo->_buf)
+    {
+        if (new_size <= sbo->_size)
+        {
+            return ptr;
+        }
+
+        /* Spill the elements from the inline buffer to the heap */
+        if ((new_ptr = malloc(new_size)))
+        {
+            memcpy(new_ptr, ptr, old_size);
+            sbo->_in_use = FALSE;
+        }
+
+        return new_ptr;
+    }
+
+    /* Move the elements back to the inline buffer when the vec shrinks enough */
+    if ((!sbo->_in_use) && (new_size <= sbo->_size))
+    {
+        memcpy(sbo->_buf, ptr, (old_size < new_size ? old_size : new_size));
+        free(ptr);
+        sbo->_in_use = TRUE;
+        return sbo->_buf;
+    }
+
+    return realloc(ptr, new_size);
+}
+
+static void _vec_sbo_free(void *ctx, void *ptr, size_t size)
+{
+    vec_sbo *sbo = (vec_sbo *)ctx;
+
+    if (ptr == sbo->_buf)
+    {
+        sbo->_in_use = FALSE;
+    }
+    else
+    {
+        free(ptr);
+    }
+
+    (void)size;
+}
+
+int _impl_vec_init_sbo(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, vec_sbo *sbo, void *buf, vec_size_t capacity)
+{
+    vec_size_t rounded = VEC_ROUND_CAPACITY(capacity);
+
+    if ((!sbo) || (!buf) || (!capacity))
+    {
+        return FALSE;
+    }
+
+    sbo->allocator.alloc_fn = _vec_sbo_alloc;
+    sbo->allocator.realloc_fn = _vec_sbo_realloc;
+    sbo->allocator.free_fn = _vec_sbo_free;
+    sbo->allocator.ctx = sbo;
+    sbo->allocator.file_backed = FALSE;
+    sbo->_buf = buf;
+    sbo->_size = (size_t)capacity * t_size;
+    sbo->_in_use = FALSE;
+
+    if (!_impl_vec_init_alloc(vec_ptr, t_size, &sbo->allocator))
+    {
+        return FALSE;
+    }
+
+    /* Take the inline buffer right away, so the first elements don't go through the growth path.
+     * If the capacity mode would round the capacity beyond the buffer, the vec only uses the
+     * largest capacity that the mode allows within it */
+    if (rounded != capacity)
+    {
+        rounded >>= 1;
+    }
+
+    vec_ptr->_mem = (unsigned char *)_vec_sbo_alloc(sbo, sbo->_size);
+    vec_ptr->capacity = rounded;
+
+    return TRUE;
+}
+
+#ifdef __cplusplus
+} /* extern "C" { */
+#endif /* __cplusplus */
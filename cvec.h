@@ -1,693 +1,1669 @@
-/**
- * @file    cvec.h
- * @author  Isaac Garzon
- * @since   24/02/2015
- *
- * @section DESCRIPTION
- *
- *  A generic vector implementation in ANSI C.
- *
- * @section LICENSE
- *
- *  Copyright (c) 2015 Isaac Garzon
- *
- *  Permission is hereby granted, free of charge, to any person obtaining a copy
- *  of this software and associated documentation files (the "Software"), to deal
- *  in the Software without restriction, including without limitation the rights
- *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
- *  copies of the Software, and to permit persons to whom the Software is
- *  furnished to do so, subject to the following conditions:
- *
- *  The above copyright notice and this permission notice shall be included in
- *  all copies or substantial portions of the Software.
- *
- *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
- *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
- *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
- *  THE SOFTWARE
- */
-
-#ifdef _MSC_VER
-#   pragma once
-#endif
-
-#ifndef _GENERIC_CVEC_H_
-#define _GENERIC_CVEC_H_
-
-/****************************************************************************************
-  Internal Macro Definitions
- ***************************************************************************************/
-/**
- * @internal
- * Defines NULL in case it's not defined already
- */
-#ifndef NULL
-#    define NULL 0
-#endif
-
-/**
- * @internal
- * Defines FALSE in case it's not defined already
- */
-#ifndef FALSE
-#    define FALSE 0
-#endif
-
-/**
- * @internal
- * Defines TRUE in case it's not defined already
- */
-#ifndef TRUE
-#    define TRUE (!FALSE)
-#endif
-
-/**
- * @internal
- * Simple concatenation macros.
- */
-#define _VEC_CAT(a, b) _X_VEC_CAT(a, b)
-#define _X_VEC_CAT(a, b) a##b
-
-/**
- * @internal
- * Defines the type name for the generic vec type
- */
-#define _IMPL_VEC_STRUCT_NAME   _impl_vec_struct
-#define _IMPL_VEC_CMPFN_NAME    _impl_vec_cmpfn
-
-/**
- * @internal
- * Defines a <code>vec</code> struct of type <code>type</code>
- * with the name <code>name</code>
- */
-#define _impl_vec_def_struct(type, name) \
-typedef struct _VEC_CAT(_vectag, name) \
-{ \
-    unsigned int start; \
-    unsigned int size; \
-    unsigned int capacity; \
-    unsigned int _t_size; \
-    type        *_mem; \
-} name
-
-/**
- * @internal
- * Defines a comparer function pointer type for a <code>vec</code> of
- * type <code>type</code> with the name <code>name</code>
- */
-#define _impl_vec_def_cmp(type, name) typedef int (*name)(const type *, const type *)
-
-/****************************************************************************************
-  Internal Type Definitions
- ***************************************************************************************/
-/**
- * @internal
- * Declares the generic <code>vec</code> structure
- */
-struct _VEC_CAT(_vectag, _IMPL_VEC_STRUCT_NAME);
-typedef struct _VEC_CAT(_vectag, _IMPL_VEC_STRUCT_NAME) _IMPL_VEC_STRUCT_NAME;
-
-/**
- * @internal
- * Defines the generic comparer function.
- */
-_impl_vec_def_cmp(void, _IMPL_VEC_CMPFN_NAME);
-
-/****************************************************************************************
-  Internal Function Declarations
- ***************************************************************************************/
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-/**
- * @internal
- * @brief   Initializes a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] t_size    The size of the type in bytes
- *                      (the result of the <code>sizeof</code> operator).
- *
- * @return    TRUE if the initialization succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_init)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int t_size);
-
-/**
- * @internal
- * @brief   Reserves memory in a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] capacity  The capacity to reserve.
- *
- * @note      Memory is only allocated if @p capacity exceeds the current
- *            capacity. Otherwise this function does nothing.
- *
- * @return    TRUE if the reservation succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_reserve)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int capacity);
-
-/**
- * @internal
- * @brief   Gets the count of elements stored in a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- *
- * @return    The count of elements stored in the <code>vec</code>.
- */
-extern unsigned int (_impl_vec_size)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
-
-/**
- * @internal
- * @brief   Gets the capacity of a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- *
- * @return    The capacity of the <code>vec</code>.
- */
-extern unsigned int (_impl_vec_capacity)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
-
-/**
- * @internal
- * @brief   Gets an element from a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] idx       The index of the element.
- *
- * @return    Pointer to the element if @p vec_ptr and @p idx are valid.
- *            NULL otherwise.
- */
-extern void* (_impl_vec_get)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx);
-
-/**
- * @internal
- * @brief   Gets the last element in a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- *
- * @return    Pointer to the last element if any. NULL otherwise.
- */
-extern void* (_impl_vec_last)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
-
-/**
- * @internal
- * @brief   Assigns a value to an element in a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] idx       The index to assign the value to.
- * @param[in] val       Pointer to the value to assign.
- *
- * @note      @p idx is valid only if its value is between 0 and the
- *            <code>vec</code>'s size (inclusive).
- *
- * @return    TRUE if the assignment succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_assign)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, const void *val);
-
-/**
- * @internal
- * @brief   Swaps two elements in a <code>vec</code>
- *
- * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
- * @param[in]  first    The index of the first element.
- * @param[in]  second   The index of the second element.
- * @param[out] tmp      Pointer to a temporary value to use during the swap.
- *
- * @return     TRUE if the swap suceeded. FALSE otherwise.
- */
-extern int (_impl_vec_swap)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int first, unsigned int second, void *tmp);
-
-/**
- * @internal
- * @brief   Sorts a <code>vec</code>
- *
- * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
- * @param[in]  cmpfn    Pointer to comparer function.
- * @param[out] tmp      Pointer to a temporary value to use during the sort.
- *
- * @return     TRUE if the sort succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_sort)(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, void *tmp);
-
-/**
- * @internal
- * @brief   Pushes a value to the end of a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] val       Pointer to the value to push.
- *
- * @return    TRUE if the push succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_push)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val);
-
-/**
- * @internal
- * @brief   Pushes an array of values to the end of a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] val       The array to push.
- * @param[in] len       The amount of elements to push.
- *
- * @return    TRUE if the push succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_pusharr)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, unsigned int len);
-
-/**
- * @internal
- * @brief   Pops an element from the end of a <code>vec</code>
- *
- * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[out] out       Optional pointer to store the popped element in.
- *
- * @return    TRUE if the pop succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_pop)(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *out);
-
-/**
- * @internal
- * @brief   Pops an array from the end of a <code>vec</code>
- *
- * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in]  len       The amount of elements to pop.
- * @param[out] out       Optional pointer to store the popped elements in.
- *
- * @return    TRUE if the pop succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_poparr)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int len, void *out);
-
-/**
- * @internal
- * @brief   Inserts an value at a specific index in a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in] val       Pointer to the value to insert.
- * @param[in] idx       The index at which to insert the value.
- * @param[in] len       The amount of elements to insert.
- *
- * @return    TRUE if the insertion succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_insert)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, unsigned int idx, unsigned int len);
-
-/**
- * @internal
- * @brief   Removes elements at a specific index from a <code>vec</code>
- *
- * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
- * @param[in]  idx       The index of the element to remove.
- * @param[in]  len       The amount of elements to remove.
- * @param[out] out       Optional pointer to store the removed elements in.
- *
- * @return    TRUE if the removal succeeded. FALSE otherwise.
- */
-extern int (_impl_vec_erase)(_IMPL_VEC_STRUCT_NAME *vec_ptr, unsigned int idx, unsigned int len, void *out);
-
-/**
- * @internal
- * @brief   Clears a <code>vec</code>
- *
- * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
- *
- * @note    This function must be called after there's no more use for
- *          the initialized <code>vec</code>.
- */
-extern void (_impl_vec_clear)(_IMPL_VEC_STRUCT_NAME *vec_ptr);
-
-#ifdef __cplusplus
-} /* extern "C" { */
-#endif /* __cplusplus */
-
-/****************************************************************************************
-  External Macro Definitions
- ***************************************************************************************/
-#define vec_init(type) _VEC_CAT(_vec_init, type)
-#define vec_size(type) _VEC_CAT(_vec_size, type)
-#define vec_capacity(type) _VEC_CAT(_vec_capacity, type)
-#define vec_empty(type) _VEC_CAT(_vec_empty, type)
-#define vec_get(type) _VEC_CAT(_vec_get, type)
-#define vec_first(type) _VEC_CAT(_vec_first, type)
-#define vec_last(type) _VEC_CAT(_vec_last, type)
-#define vec_swap(type) _VEC_CAT(_vec_swap, type)
-#define vec_sort(type) _VEC_CAT(_vec_sort, type)
-#define vec_pop(type) _VEC_CAT(_vec_pop, type)
-#define vec_poparr(type) _VEC_CAT(_vec_poparr, type)
-#define vec_unshift(type) _VEC_CAT(_vec_unshift, type)
-#define vec_unshiftarr(type) _VEC_CAT(_vec_unshiftarr, type)
-#define vec_insert(type) _VEC_CAT(_vec_insert, type)
-#define vec_insertptr(type) _VEC_CAT(_vec_insertptr, type)
-#define vec_insertarr(type) _VEC_CAT(_vec_insertarr, type)
-#define vec_assignptr(type) _VEC_CAT(_vec_assignptr, type)
-#define vec_assign(type) _VEC_CAT(_vec_assign, type)
-#define vec_push(type) _VEC_CAT(_vec_push, type)
-#define vec_pushptr(type) _VEC_CAT(_vec_pushptr, type)
-#define vec_pusharr(type) _VEC_CAT(_vec_pusharr, type)
-#define vec_shift(type) _VEC_CAT(_vec_shift, type)
-#define vec_shiftptr(type) _VEC_CAT(_vec_shiftptr, type)
-#define vec_shiftarr(type) _VEC_CAT(_vec_shiftarr, type)
-#define vec_erase(type) _VEC_CAT(_vec_erase, type)
-#define vec_clear(type) _VEC_CAT(_vec_clear, type)
-
-/**
- * Gets the type name for <code>vec</code> of type <code>type</code>
- *
- * @param[in] type  The type that is stored in the vec.
- */
-#define vec_type(type)      _VEC_CAT(_vec, type)
-
-/**
- * Gets the type name of a comparer function pointer for
- * a <code>vec</code> of type <code>type</code>
- *
- * @param[in] type  The type that is stored in the vec.
- */
-#define vec_cmp_type(type)  _VEC_CAT(_vec_cmp, vec_type(type))
-
-/**
- * Defines a <code>vec</code> of type <code>type</code>
- * and its associated functionality
- */
-#define using_vec_type(type)    \
-    _impl_vec_def_struct(type, vec_type(type)); \
-    _impl_vec_def_cmp(type, vec_cmp_type(type)); \
-    \
-    /**
-     * @brief   Initializes a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @return    TRUE if the initialization succeeded. FALSE otherwise.
-     */ \
-    static int (_VEC_CAT(_vec_init, type))(vec_type(type) *vec_ptr) { \
-        return (_impl_vec_init)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, sizeof(type)); \
-    } \
-    /**
-     * @brief   Reserves memory in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] capacity  The capacity to reserve.
-     *
-     * @note      Memory is only allocated if @p capacity exceeds the current
-     *            capacity. Otherwise this function does nothing.
-     *
-     * @return    TRUE if the reservation succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_reserve, type)(vec_type(type) *vec_ptr, unsigned int capacity) { \
-        return (_impl_vec_reserve)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, capacity); \
-    } \
-    /**
-     * @brief   Gets the count of elements stored in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @return    The count of elements stored in the <code>vec</code>.
-     */ \
-    static unsigned int _VEC_CAT(_vec_size, type)(vec_type(type) *vec_ptr) { \
-        return (_impl_vec_size)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
-    } \
-    /**
-     * @brief   Gets the capacity of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @return    The capacity of the <code>vec</code>.
-     */ \
-    static unsigned int _VEC_CAT(_vec_capacity, type)(vec_type(type) *vec_ptr) { \
-        return (_impl_vec_capacity)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
-    } \
-    /**
-     * @brief   Checks if a <code>vec</code> is empty.
-     *
-     * @return  TRUE if the <code>vec</code> is empty. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_empty, type)(vec_type(type) *vec_ptr) { \
-        return (_impl_vec_size)((_IMPL_VEC_STRUCT_NAME *)vec_ptr) == 0; \
-    } \
-    /**
-     * @brief   Gets an element from a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
-     * @param[in] idx       The index of the element.
-     *
-     * @return    Pointer to the element if @p vec_ptr and @p idx are valid.
-     *            NULL otherwise.
-     */ \
-    static type* _VEC_CAT(_vec_get, type)(vec_type(type) *vec_ptr, unsigned int idx) { \
-        return (type *)(_impl_vec_get)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx); \
-    } \
-    /**
-     * @brief   Gets the first element in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @return    Pointer to the first element if any. NULL otherwise.
-     */ \
-    static type* _VEC_CAT(_vec_first, type)(vec_type(type) *vec_ptr) { \
-        return (type *)(_impl_vec_get)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0); \
-    } \
-    /**
-     * @brief   Gets the last element in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @return    Pointer to the last element if any. NULL otherwise.
-     */ \
-    static type* _VEC_CAT(_vec_last, type)(vec_type(type) *vec_ptr) { \
-        return (type *)(_impl_vec_last)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
-    } \
-    /**
-     * @brief   Swaps two elements in a <code>vec</code>
-     *
-     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
-     * @param[in]  first    The index of the first element.
-     * @param[in]  second   The index of the second element.
-     *
-     * @return     TRUE if the swap suceeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_swap, type)(vec_type(type) *vec_ptr, unsigned int first, unsigned int second) { \
-        unsigned char tmp[sizeof(type)]; \
-        return (_impl_vec_swap)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, first, second, tmp); \
-    } \
-    /**
-     * @brief   Sorts a <code>vec</code>
-     *
-     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
-     * @param[in]  cmpfn    Pointer to comparer function for type <code>type</code>.
-     *
-     * @return    TRUE if the sort succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_sort, type)(vec_type(type) *vec_ptr, vec_cmp_type(type) cmpfn) { \
-        unsigned char tmp[sizeof(type)]; \
-        return (_impl_vec_sort)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, (_IMPL_VEC_CMPFN_NAME)cmpfn, tmp); \
-    } \
-    /**
-     * @brief   Assigns a value passed by a pointer to an element in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] idx       The index to assign the value to.
-     * @param[in] val       Pointer to the value to assign.
-     *
-     * @note      @p idx is valid only if its value is between 0 and the
-     *            <code>vec</code>'s size (inclusive).
-     *
-     * @return    TRUE if the assignment succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_assignptr, type)(vec_type(type) *vec_ptr, unsigned int idx, const type *val) { \
-        return (_impl_vec_assign)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, val); \
-    } \
-    /**
-     * @brief   Assigns a value to an element in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] idx       The index to assign the value to.
-     * @param[in] val       The value to assign.
-     *
-     * @note      @p idx is valid only if its value is between 0 and the
-     *            <code>vec</code>'s size (inclusive).
-     *
-     * @return    TRUE if the assignment succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_assign, type)(vec_type(type) *vec_ptr, unsigned int idx, const type val) { \
-        return (_impl_vec_assign)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, &val); \
-    } \
-    /**
-     * @brief   Pushes a value passed by a pointer to the end of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       Pointer to the value to push.
-     *
-     * @return    TRUE if the push succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_pushptr, type)(vec_type(type) *vec_ptr, const type *val) { \
-        return (_impl_vec_push)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val); \
-    } \
-    /**
-     * @brief   Pushes an array of values to the end of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The array to push.
-     * @param[in] len       The amount of elements from the array to push.
-     *
-     * @return    TRUE if the push succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_pusharr, type)(vec_type(type) *vec_ptr, const type *val, unsigned int len) { \
-        return (_impl_vec_pusharr)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, len); \
-    } \
-    /**
-     * @brief   Pushes a value to the end of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The value to push.
-     *
-     * @return    TRUE if the push succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_push, type)(vec_type(type) *vec_ptr, const type val) { \
-        return (_impl_vec_push)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val); \
-    } \
-    /**
-     * @brief   Pops an array of elements from the end of a <code>vec</code>
-     *
-     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in]  len       The amount of elements to pop from the <code>vec</code>.
-     * @param[out] out       Optional pointer to store the popped elements in.
-     *
-     * @return    TRUE if the pop succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_poparr, type)(vec_type(type) *vec_ptr, unsigned int len, type *out) { \
-        return (_impl_vec_poparr)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, len, out); \
-    } \
-    /**
-     * @brief   Pops an element from the end of a <code>vec</code>
-     *
-     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[out] out       Optional pointer to store the popped element in.
-     *
-     * @return    TRUE if the pop succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_pop, type)(vec_type(type) *vec_ptr, type *out) { \
-        return (_impl_vec_pop)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, out); \
-    } \
-    /**
-     * @brief   Shifts a value passed by a pointer to the beginning of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       Pointer to the value to shift.
-     *
-     * @return    TRUE if the shift succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_shiftptr, type)(vec_type(type) *vec_ptr, const type *val) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, 0, 1); \
-    } \
-    /**
-     * @brief   Shifts an array of values to the beginning of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The array to shift.
-     * @param[in] len       The amount of elements to shift.
-     *
-     * @return    TRUE if the shift succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_shiftarr, type)(vec_type(type) *vec_ptr, const type *val, unsigned int len) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, 0, len); \
-    } \
-    /**
-     * @brief   Shifts a value to the beginning of a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The value to shift.
-     *
-     * @return    TRUE if the shift succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_shift, type)(vec_type(type) *vec_ptr, const type val) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val, 0, 1); \
-    } \
-    /**
-     * @brief   Unshifts an array of elements from the beginning of a <code>vec</code>
-     *
-     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in]  len       The amount of elements to unshift.
-     * @param[out] out       Optional pointer to store the unshifted elements in.
-     *
-     * @return    TRUE if the unshift succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_unshiftarr, type)(vec_type(type) *vec_ptr, unsigned int len, type *out) { \
-        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0, len, out); \
-    } \
-    /**
-     * @brief   Unshifts an element from the beginning of a <code>vec</code>
-     *
-     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[out] out       Optional pointer to store the unshifted element in.
-     *
-     * @return    TRUE if the unshift succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_unshift, type)(vec_type(type) *vec_ptr, type *out) { \
-        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0, 1, out); \
-    } \
-    /**
-     * @brief   Inserts an value passed by a pointer at a specific index in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       Pointer to the value to insert.
-     * @param[in] idx       The index at which to insert the value.
-     *
-     * @return    TRUE if the insertion succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_insertptr, type)(vec_type(type) *vec_ptr, const type *val, unsigned int idx) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, idx, 1); \
-    } \
-    /**
-     * @brief   Inserts an array of values at a specific index in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The array to insert.
-     * @param[in] idx       The index at which to insert the value.
-     * @param[in] len       The amount of elements to insert.
-     *
-     * @return    TRUE if the insertion succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_insertarr, type)(vec_type(type) *vec_ptr, const type *val, unsigned int idx, unsigned int len) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, idx, len); \
-    } \
-    /**
-     * @brief   Inserts an value at a specific index in a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in] val       The value to insert.
-     * @param[in] idx       The index at which to insert the value.
-     *
-     * @return    TRUE if the insertion succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_insert, type)(vec_type(type) *vec_ptr, const type val, unsigned int idx) { \
-        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val, idx, 1); \
-    } \
-    /**
-     * @brief   Removes elements at a specific index from a <code>vec</code>
-     *
-     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
-     * @param[in]  idx       The index of the element to remove.
-     * @param[in]  len       The amount of elements to remove.
-     * @param[out] out       Optional pointer to store the removed elements in.
-     *
-     * @return    TRUE if the removal succeeded. FALSE otherwise.
-     */ \
-    static int _VEC_CAT(_vec_erase, type)(vec_type(type) *vec_ptr, unsigned int idx, unsigned int len, type *out) { \
-        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, len, out); \
-    } \
-    /**
-     * @brief   Clears a <code>vec</code>
-     *
-     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
-     *
-     * @note    This function must be called after there's no more use for
-     *          the initialized <code>vec</code>.
-     */ \
-    static void _VEC_CAT(_vec_clear, type)(vec_type(type) *vec_ptr) { \
-        (_impl_vec_clear)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
-    } \
-    /*
-     * Add a dummy typedef to require insertion of a semicolon after a using_vec_type declaration.
-     */ \
-    typedef vec_cmp_type(type) *_VEC_CAT(_p, vec_cmp_type(type))
-
-#endif /* !_GENERIC_CVEC_H_ */
+/**
+ * @file    cvec.h
+ * @author  Isaac Garzon
+ * @since   24/02/2015
+ *
+ * @section DESCRIPTION
+ *
+ *  A generic vector implementation in ANSI C.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#ifdef _MSC_VER
+#   pragma once
+#endif
+
+#ifndef _GENERIC_CVEC_H_
+#define _GENERIC_CVEC_H_
+
+#include <stddef.h>
+
+/****************************************************************************************
+  Size Type Definition
+ ***************************************************************************************/
+/**
+ * Defines the type of the sizes, capacities and indices of a <code>vec</code>.
+ * When CVEC_LARGE_SIZE is defined it's <code>size_t</code>, which allows vecs with
+ * more than <code>UINT_MAX</code> elements. Otherwise it's <code>unsigned int</code>.
+ */
+#ifdef CVEC_LARGE_SIZE
+typedef size_t vec_size_t;
+#else
+typedef unsigned int vec_size_t;
+#endif /* CVEC_LARGE_SIZE */
+
+/****************************************************************************************
+  Internal Macro Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * Defines NULL in case it's not defined already
+ */
+#ifndef NULL
+#    define NULL 0
+#endif
+
+/**
+ * @internal
+ * Defines FALSE in case it's not defined already
+ */
+#ifndef FALSE
+#    define FALSE 0
+#endif
+
+/**
+ * @internal
+ * Defines TRUE in case it's not defined already
+ */
+#ifndef TRUE
+#    define TRUE (!FALSE)
+#endif
+
+/**
+ * @internal
+ * Simple concatenation macros.
+ */
+#define _VEC_CAT(a, b) _X_VEC_CAT(a, b)
+#define _X_VEC_CAT(a, b) a##b
+
+/**
+ * @internal
+ * Defines the type name for the generic vec type
+ */
+#define _IMPL_VEC_STRUCT_NAME   _impl_vec_struct
+#define _IMPL_VEC_CMPFN_NAME    _impl_vec_cmpfn
+#define _IMPL_VEC_SPAN_NAME     _impl_vec_span
+
+/**
+ * @internal
+ * Defines the statistics counters field of a <code>vec</code> struct
+ * if CVEC_STATS is defined. Otherwise the struct doesn't carry them at all.
+ */
+#ifdef CVEC_STATS
+#    define _VEC_STATS_FIELD vec_statistics _stats;
+#else
+#    define _VEC_STATS_FIELD
+#endif /* CVEC_STATS */
+
+/**
+ * @internal
+ * Defines a <code>vec</code> struct of type <code>type</code>
+ * with the name <code>name</code>
+ */
+#define _impl_vec_def_struct(type, name) \
+typedef struct _VEC_CAT(_vectag, name) \
+{ \
+    vec_size_t               start; \
+    vec_size_t               size; \
+    vec_size_t               capacity; \
+    vec_size_t               _t_size; \
+    type                    *_mem; \
+    const vec_allocator     *_alloc; \
+    const vec_growth_policy *_growth; \
+    _VEC_STATS_FIELD \
+} name
+
+/**
+ * @internal
+ * Defines a comparer function pointer type for a <code>vec</code> of
+ * type <code>type</code> with the name <code>name</code>
+ */
+#define _impl_vec_def_cmp(type, name) typedef int (*name)(const type *, const type *)
+
+/**
+ * @internal
+ * Defines a span of contiguous elements of type <code>type</code>
+ * with the name <code>name</code>
+ */
+#define _impl_vec_def_span(type, name) \
+typedef struct _VEC_CAT(_vectag, name) \
+{ \
+    type      *data; \
+    vec_size_t size; \
+} name
+
+/**
+ * @internal
+ * Defines a slice of a <code>vec</code> of type <code>type</code> with the name <code>name</code>,
+ * which is made of the spans of the slice's elements before and after the buffer end.
+ */
+#define _impl_vec_def_slice(type, name) \
+typedef struct _VEC_CAT(_vectag, name) \
+{ \
+    vec_span_type(type) seg[2]; \
+    vec_size_t          size; \
+} name
+
+/**
+ * @internal
+ * Defines the inline function specifier for the header-inlined functions
+ */
+#if defined(__cplusplus) || (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L))
+#    define _VEC_INLINE inline
+#elif defined(__GNUC__)
+#    define _VEC_INLINE __inline__
+#elif defined(_MSC_VER)
+#    define _VEC_INLINE __inline
+#else
+#    define _VEC_INLINE
+#endif
+
+/**
+ * @internal
+ * Wraps a ring index <code>idx</code> that is less than twice the
+ * capacity <code>max</code> around the end of the <code>vec</code> buffer
+ */
+#ifdef CVEC_POW2_CAPACITY
+#    define _impl_vec_wrap(idx, max) ((idx) & ((max) - 1))
+#else
+#    define _impl_vec_wrap(idx, max) ((idx) % (max))
+#endif
+
+/****************************************************************************************
+  Internal Type Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * Declares the generic <code>vec</code> structure
+ */
+struct _VEC_CAT(_vectag, _IMPL_VEC_STRUCT_NAME);
+typedef struct _VEC_CAT(_vectag, _IMPL_VEC_STRUCT_NAME) _IMPL_VEC_STRUCT_NAME;
+
+/**
+ * @internal
+ * Defines the generic comparer function.
+ */
+_impl_vec_def_cmp(void, _IMPL_VEC_CMPFN_NAME);
+
+/**
+ * @internal
+ * Defines the generic span.
+ */
+_impl_vec_def_span(void, _IMPL_VEC_SPAN_NAME);
+
+/****************************************************************************************
+  External Type Definitions
+ ***************************************************************************************/
+/**
+ * Defines an allocator for the memory of a <code>vec</code>.
+ * Each function gets the allocator's context as its first argument.
+ */
+typedef struct vec_allocator
+{
+    /** Allocates @p size bytes. Returns NULL on failure */
+    void* (*alloc_fn)(void *ctx, size_t size);
+    /** Resizes the allocation at @p ptr of @p old_size bytes to @p new_size bytes.
+     *  Returns NULL on failure, in which case @p ptr must remain valid */
+    void* (*realloc_fn)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    /** Frees the allocation at @p ptr of @p size bytes */
+    void  (*free_fn)(void *ctx, void *ptr, size_t size);
+    /** The context passed to the functions above */
+    void  *ctx;
+    /** Non-zero if the allocations are backed by a file, in which case temporary buffers
+     *  (e.g. sort scratch) are allocated with malloc() instead of these functions */
+    int    file_backed;
+} vec_allocator;
+
+/**
+ * Defines how a <code>vec</code> grows when it runs out of capacity.
+ * A vec without a growth policy starts with 5 elements (8 when
+ * CVEC_POW2_CAPACITY is defined) and doubles its capacity.
+ */
+typedef struct vec_growth_policy
+{
+    /** The numerator of the growth factor (e.g. 3 for 1.5x) */
+    vec_size_t factor_num;
+    /** The denominator of the growth factor (e.g. 2 for 1.5x). Must be less than factor_num */
+    vec_size_t factor_den;
+    /** The capacity of the first allocation. 0 for the default */
+    vec_size_t min_capacity;
+    /** The maximal amount of elements to grow by at once. 0 for unbounded */
+    vec_size_t max_step;
+    /** The allocation size in bytes is rounded up to a multiple of it
+     *  (e.g. the page size or an allocator size class). 0 for none */
+    size_t     granularity;
+    /** When elements are removed and the size drops below the capacity divided by it,
+     *  the capacity shrinks to twice the size (but not below min_capacity).
+     *  Must be greater than 2 to avoid thrashing. 0 to never shrink automatically */
+    vec_size_t shrink_divisor;
+} vec_growth_policy;
+
+#ifdef CVEC_STATS
+/**
+ * Defines the counters a <code>vec</code> keeps about its memory management
+ * when CVEC_STATS is defined. They cover the whole lifetime of the vec,
+ * so clearing it doesn't reset them.
+ */
+typedef struct vec_statistics
+{
+    /** The amount of buffers allocated for the elements. Failed allocations and
+     *  temporary buffers (e.g. for sorting) aren't counted */
+    unsigned long allocs;
+    /** The amount of times the buffer was resized by the allocator's realloc */
+    unsigned long reallocs;
+    /** The amount of times the elements were copied to a newly allocated buffer
+     *  when growing or shrinking instead of resizing the buffer */
+    unsigned long copies;
+    /** The amount of bytes of elements moved in memory to make room for elements,
+     *  to close the gaps of removed ones, or to change the buffer */
+    size_t        bytes_moved;
+    /** The amount of times the elements started circulating beyond the buffer end */
+    unsigned long wraps;
+    /** The amount of times the elements that circulated beyond the buffer end were
+     *  rotated back to make them contiguous (e.g. by vec_data or vec_sort) */
+    unsigned long rotations;
+    /** The largest size of the vec */
+    vec_size_t    high_water;
+} vec_statistics;
+#endif /* CVEC_STATS */
+
+/**
+ * @internal
+ * Declares the block type of a <code>vec_arena</code>
+ */
+struct _vec_arena_block;
+
+/**
+ * Defines a bump allocator that carves allocations out of large blocks,
+ * and frees all of them at once when released.
+ */
+typedef struct vec_arena
+{
+    /** The allocator to attach to the vecs allocated from the arena */
+    vec_allocator            allocator;
+    struct _vec_arena_block *_blocks;
+    size_t                   _block_size;
+} vec_arena;
+
+/**
+ * Defines the state of the inline buffer of a <code>vec</code> declared with
+ * <code>using_vec_type_sbo</code>. Its allocator hands out the buffer while it's
+ * unused and big enough, and falls back to <code>malloc()</code> otherwise.
+ */
+typedef struct vec_sbo
+{
+    /** The allocator attached to the vec */
+    vec_allocator allocator;
+    void         *_buf;
+    size_t        _size;
+    int           _in_use;
+} vec_sbo;
+
+/****************************************************************************************
+  Internal Function Declarations
+ ***************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @internal
+ * @brief   Initializes a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] t_size    The size of the type in bytes
+ *                      (the result of the <code>sizeof</code> operator).
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_init)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size);
+
+/**
+ * @internal
+ * @brief   Initializes a <code>vec</code> that allocates its memory using an allocator
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] t_size    The size of the type in bytes
+ *                      (the result of the <code>sizeof</code> operator).
+ * @param[in] alloc     Pointer to the allocator to use. Must remain valid
+ *                      while the <code>vec</code> is in use.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_init_alloc)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, const vec_allocator *alloc);
+
+/**
+ * @internal
+ * @brief   Reserves memory in a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] capacity  The capacity to reserve.
+ *
+ * @note      Memory is only allocated if @p capacity exceeds the current
+ *            capacity. Otherwise this function does nothing.
+ *            The capacity is rounded up according to the granularity of
+ *            the growth policy, and when CVEC_POW2_CAPACITY is defined
+ *            to the next power of two.
+ *
+ * @return    TRUE if the reservation succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_reserve)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t capacity);
+
+/**
+ * @internal
+ * @brief   Makes room for more elements in a <code>vec</code> according to its growth policy
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] len       The amount of elements to make room for.
+ *
+ * @note      Memory is only allocated if there's no room for @p len more elements.
+ *
+ * @return    TRUE if there's room for @p len more elements. FALSE otherwise.
+ */
+extern int (_impl_vec_grow)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Adds elements that were written past the end of a <code>vec</code> to its size
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] len       The amount of elements that were written.
+ *
+ * @note      The caller must have made room for @p len more elements. Every function that
+ *            appends elements in place goes through here, so they're counted in the
+ *            statistics when CVEC_STATS is defined.
+ */
+extern void (_impl_vec_advance)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Allocates a temporary buffer for an operation on a <code>vec</code> (e.g. sorting)
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] size      The size of the buffer in bytes.
+ *
+ * @note      The buffer comes from the allocator of the <code>vec</code>, or from malloc()
+ *            if it has none or its memory is backed by a file.
+ *
+ * @return    Pointer to the buffer, or NULL if the allocation failed.
+ */
+extern void* (_impl_vec_scratch_alloc)(_IMPL_VEC_STRUCT_NAME *vec_ptr, size_t size);
+
+/**
+ * @internal
+ * @brief   Frees a buffer allocated by <code>_impl_vec_scratch_alloc</code>
+ *
+ * @param[in] vec_ptr   Pointer to the generic <code>vec</code> structure the buffer was allocated for.
+ * @param[in] ptr       Pointer to the buffer.
+ * @param[in] size      The size of the buffer in bytes.
+ */
+extern void (_impl_vec_scratch_free)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, void *ptr, size_t size);
+
+/**
+ * @internal
+ * @brief   Shrinks the capacity of a <code>vec</code> to fit its size
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ *
+ * @note      The capacity is still rounded up according to the growth policy
+ *            and the capacity mode. An empty <code>vec</code> frees its memory.
+ *
+ * @return    TRUE if the shrinking succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_shrink_to_fit)(_IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Sets the growth policy of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] policy    Pointer to the growth policy to use, or NULL for the default
+ *                      policy. Must remain valid while the <code>vec</code> is in use.
+ *
+ * @return    TRUE if the policy is valid. FALSE otherwise.
+ */
+extern int (_impl_vec_set_growth)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const vec_growth_policy *policy);
+
+/**
+ * @internal
+ * @brief   Gets the count of elements stored in a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ *
+ * @return    The count of elements stored in the <code>vec</code>.
+ */
+extern vec_size_t (_impl_vec_size)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Gets the capacity of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ *
+ * @return    The capacity of the <code>vec</code>.
+ */
+extern vec_size_t (_impl_vec_capacity)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Gets an element from a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] idx       The index of the element.
+ *
+ * @return    Pointer to the element if @p vec_ptr and @p idx are valid.
+ *            NULL otherwise.
+ */
+extern void* (_impl_vec_get)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx);
+
+/**
+ * @internal
+ * @brief   Gets the last element in a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ *
+ * @return    Pointer to the last element if any. NULL otherwise.
+ */
+extern void* (_impl_vec_last)(const _IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Assigns a value to an element in a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] idx       The index to assign the value to.
+ * @param[in] val       Pointer to the value to assign.
+ *
+ * @note      @p idx is valid only if its value is between 0 and the
+ *            <code>vec</code>'s size (inclusive).
+ *
+ * @return    TRUE if the assignment succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_assign)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, const void *val);
+
+/**
+ * @internal
+ * @brief   Swaps two elements in a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  first    The index of the first element.
+ * @param[in]  second   The index of the second element.
+ * @param[out] tmp      Pointer to a temporary value to use during the swap.
+ *
+ * @return     TRUE if the swap suceeded. FALSE otherwise.
+ */
+extern int (_impl_vec_swap)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t first, vec_size_t second, void *tmp);
+
+/**
+ * @internal
+ * @brief   Aligns the elements of a <code>vec</code> so they are contiguous in memory
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ *
+ * @return     TRUE if the alignment succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_align)(_IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Gets a pointer to the elements of a <code>vec</code> as a contiguous array
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ *
+ * @note       The elements are aligned first if they circulated beyond the end
+ *             of the <code>vec</code>'s buffer.
+ *
+ * @return     Pointer to the first element if any. NULL otherwise.
+ */
+extern void* (_impl_vec_data)(_IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Gets the spans of contiguous elements that make up a range in a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  idx      The index of the first element in the range.
+ * @param[in]  len      The amount of elements in the range.
+ * @param[out] spans    The spans of the range in logical order. The second span
+ *                      is empty unless the range circulates beyond the buffer end.
+ *
+ * @return     TRUE if the range is inside the <code>vec</code>'s bounds. FALSE otherwise.
+ */
+extern int (_impl_vec_slice)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len, _IMPL_VEC_SPAN_NAME spans[2]);
+
+/**
+ * @internal
+ * @brief   Sorts a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  cmpfn    Pointer to comparer function.
+ *
+ * @return     TRUE if the sort succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_sort)(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn);
+
+/**
+ * @internal
+ * @brief   Sorts a <code>vec</code> while keeping the order of equal elements
+ *
+ * @param[in]  vec_ptr      Pointer to a generic <code>vec</code> structure.
+ * @param[in]  cmpfn        Pointer to comparer function.
+ * @param[in]  scratch_ptr  Pointer to a generic <code>vec</code> structure of the same element
+ *                          size to use as a merge buffer, or NULL to allocate a temporary one.
+ *
+ * @note       The elements of the scratch <code>vec</code> are discarded, but its memory is kept
+ *             so that it can be reused by further sorts.
+ *
+ * @return     TRUE if the sort succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_stable_sort)(_IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, _IMPL_VEC_STRUCT_NAME *scratch_ptr);
+
+/**
+ * @internal
+ * @brief   Finds the first element in a sorted <code>vec</code> that is not less than a value
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  val      Pointer to the value to search for.
+ * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+ *
+ * @return     The index of the element, or the size of the <code>vec</code> if there's none.
+ */
+extern vec_size_t (_impl_vec_lower_bound)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn);
+
+/**
+ * @internal
+ * @brief   Finds the first element in a sorted <code>vec</code> that is greater than a value
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  val      Pointer to the value to search for.
+ * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+ *
+ * @return     The index of the element, or the size of the <code>vec</code> if there's none.
+ */
+extern vec_size_t (_impl_vec_upper_bound)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn);
+
+/**
+ * @internal
+ * @brief   Inserts a value into a sorted <code>vec</code> after the elements that are equal to it
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  val      Pointer to the value to insert.
+ * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+ *
+ * @return     TRUE if the insertion succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_insert_sorted)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, _IMPL_VEC_CMPFN_NAME cmpfn);
+
+/**
+ * @internal
+ * @brief   Pushes a value to the end of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] val       Pointer to the value to push.
+ *
+ * @return    TRUE if the push succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_push)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val);
+
+/**
+ * @internal
+ * @brief   Pushes an array of values to the end of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] val       The array to push.
+ * @param[in] len       The amount of elements to push.
+ *
+ * @return    TRUE if the push succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_pusharr)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Appends uninitialized elements to the end of a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  len      The amount of elements to append.
+ * @param[out] spans    The spans of the appended elements in logical order. The second span
+ *                      is empty unless the elements circulate beyond the buffer end.
+ *
+ * @return     TRUE if the elements were appended. FALSE otherwise.
+ */
+extern int (_impl_vec_extend)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len, _IMPL_VEC_SPAN_NAME spans[2]);
+
+/**
+ * @internal
+ * @brief   Pops an element from the end of a <code>vec</code>
+ *
+ * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[out] out       Optional pointer to store the popped element in.
+ *
+ * @return    TRUE if the pop succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_pop)(_IMPL_VEC_STRUCT_NAME *vec_ptr, void *out);
+
+/**
+ * @internal
+ * @brief   Pops an array from the end of a <code>vec</code>
+ *
+ * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in]  len       The amount of elements to pop.
+ * @param[out] out       Optional pointer to store the popped elements in.
+ *
+ * @return    TRUE if the pop succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_poparr)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t len, void *out);
+
+/**
+ * @internal
+ * @brief   Inserts an value at a specific index in a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] val       Pointer to the value to insert.
+ * @param[in] idx       The index at which to insert the value.
+ * @param[in] len       The amount of elements to insert.
+ *
+ * @return    TRUE if the insertion succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_insert)(_IMPL_VEC_STRUCT_NAME *vec_ptr, const void *val, vec_size_t idx, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Removes elements at a specific index from a <code>vec</code>
+ *
+ * @param[in]  vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in]  idx       The index of the element to remove.
+ * @param[in]  len       The amount of elements to remove.
+ * @param[out] out       Optional pointer to store the removed elements in.
+ *
+ * @return    TRUE if the removal succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_erase)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t idx, vec_size_t len, void *out);
+
+/**
+ * @internal
+ * @brief   Clears a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ *
+ * @note    This function must be called after there's no more use for
+ *          the initialized <code>vec</code>.
+ */
+extern void (_impl_vec_clear)(_IMPL_VEC_STRUCT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Initializes a <code>vec</code> that keeps its elements in an inline buffer
+ *          until it outgrows it
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] t_size    The size of the type in bytes
+ *                      (the result of the <code>sizeof</code> operator).
+ * @param[in] sbo       Pointer to the state of the inline buffer.
+ * @param[in] buf       Pointer to the inline buffer.
+ * @param[in] capacity  The amount of elements that fit in the inline buffer.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_init_sbo)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, vec_sbo *sbo, void *buf, vec_size_t capacity);
+
+#ifdef CVEC_STATS
+/**
+ * @internal
+ * @brief   Gets the statistics counters of a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[out] stats    Pointer to store the counters in.
+ *
+ * @return    TRUE if the counters were stored. FALSE otherwise.
+ */
+extern int (_impl_vec_stats)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, vec_statistics *stats);
+#endif /* CVEC_STATS */
+
+/****************************************************************************************
+  External Function Declarations
+ ***************************************************************************************/
+/**
+ * @brief   Initializes an arena allocator
+ *
+ * @param[in] arena       Pointer to a <code>vec_arena</code> structure.
+ * @param[in] block_size  The size in bytes of the blocks to carve allocations from.
+ *                        Bigger allocations get a block of their own.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (vec_arena_init)(vec_arena *arena, size_t block_size);
+
+/**
+ * @brief   Releases all the memory allocated from an arena at once
+ *
+ * @param[in] arena       Pointer to a <code>vec_arena</code> structure.
+ *
+ * @note    The vecs that were allocated from the arena must not be used after
+ *          this call, not even to clear them. The arena itself can be reused.
+ */
+extern void (vec_arena_release)(vec_arena *arena);
+
+#ifdef CVEC_STATS
+/**
+ * @brief   Gets the statistics counters of all the vecs in the process
+ *
+ * @param[out] stats    Pointer to store the counters in.
+ *
+ * @note    The counters are the sums of the counters of all the vecs, except for
+ *          the high-water mark, which is the largest one of any vec. They're
+ *          updated atomically when the compiler provides the GCC atomic builtins.
+ */
+extern void (vec_stats_global)(vec_statistics *stats);
+#endif /* CVEC_STATS */
+
+#ifdef __cplusplus
+} /* extern "C" { */
+#endif /* __cplusplus */
+
+/****************************************************************************************
+  External Macro Definitions
+ ***************************************************************************************/
+#define vec_init(type) _VEC_CAT(_vec_init, type)
+#define vec_init_with_alloc(type) _VEC_CAT(_vec_init_with_alloc, type)
+#define vec_reserve(type) _VEC_CAT(_vec_reserve, type)
+#define vec_shrink_to_fit(type) _VEC_CAT(_vec_shrink_to_fit, type)
+#define vec_set_growth(type) _VEC_CAT(_vec_set_growth, type)
+#define vec_size(type) _VEC_CAT(_vec_size, type)
+#define vec_capacity(type) _VEC_CAT(_vec_capacity, type)
+#define vec_empty(type) _VEC_CAT(_vec_empty, type)
+#define vec_get(type) _VEC_CAT(_vec_get, type)
+#define vec_first(type) _VEC_CAT(_vec_first, type)
+#define vec_last(type) _VEC_CAT(_vec_last, type)
+#define vec_swap(type) _VEC_CAT(_vec_swap, type)
+#define vec_sort(type) _VEC_CAT(_vec_sort, type)
+#define vec_stable_sort(type) _VEC_CAT(_vec_stable_sort, type)
+#define vec_lower_bound(type) _VEC_CAT(_vec_lower_bound, type)
+#define vec_upper_bound(type) _VEC_CAT(_vec_upper_bound, type)
+#define vec_bsearch(type) _VEC_CAT(_vec_bsearch, type)
+#define vec_insert_sorted(type) _VEC_CAT(_vec_insert_sorted, type)
+#define vec_data(type) _VEC_CAT(_vec_data, type)
+#define vec_segments(type) _VEC_CAT(_vec_segments, type)
+#define vec_slice(type) _VEC_CAT(_vec_slice, type)
+#define vec_slice_get(type) _VEC_CAT(_vec_slice_get, type)
+#define vec_pop(type) _VEC_CAT(_vec_pop, type)
+#define vec_poparr(type) _VEC_CAT(_vec_poparr, type)
+#define vec_unshift(type) _VEC_CAT(_vec_unshift, type)
+#define vec_unshiftarr(type) _VEC_CAT(_vec_unshiftarr, type)
+#define vec_insert(type) _VEC_CAT(_vec_insert, type)
+#define vec_insertptr(type) _VEC_CAT(_vec_insertptr, type)
+#define vec_insertarr(type) _VEC_CAT(_vec_insertarr, type)
+#define vec_assignptr(type) _VEC_CAT(_vec_assignptr, type)
+#define vec_assign(type) _VEC_CAT(_vec_assign, type)
+#define vec_push(type) _VEC_CAT(_vec_push, type)
+#define vec_pushptr(type) _VEC_CAT(_vec_pushptr, type)
+#define vec_pusharr(type) _VEC_CAT(_vec_pusharr, type)
+#define vec_emplace_back(type) _VEC_CAT(_vec_emplace_back, type)
+#define vec_extend_uninit(type) _VEC_CAT(_vec_extend_uninit, type)
+#define vec_shift(type) _VEC_CAT(_vec_shift, type)
+#define vec_shiftptr(type) _VEC_CAT(_vec_shiftptr, type)
+#define vec_shiftarr(type) _VEC_CAT(_vec_shiftarr, type)
+#define vec_erase(type) _VEC_CAT(_vec_erase, type)
+#define vec_clear(type) _VEC_CAT(_vec_clear, type)
+
+/**
+ * Gets the type name for <code>vec</code> of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the vec.
+ */
+#define vec_type(type)      _VEC_CAT(_vec, type)
+
+/**
+ * Gets the type name of a comparer function pointer for
+ * a <code>vec</code> of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the vec.
+ */
+#define vec_cmp_type(type)  _VEC_CAT(_vec_cmp, vec_type(type))
+
+/**
+ * @internal
+ * Defines the header-inlined unchecked accessors for a <code>vec</code> of
+ * type <code>type</code> if CVEC_UNCHECKED_ACCESSORS is defined.
+ * These accessors don't validate the <code>vec</code> or the indices passed to them.
+ */
+#ifdef CVEC_UNCHECKED_ACCESSORS
+#define vec_get_unchecked(type) _VEC_CAT(_vec_get_unchecked, type)
+#define vec_first_unchecked(type) _VEC_CAT(_vec_first_unchecked, type)
+#define vec_last_unchecked(type) _VEC_CAT(_vec_last_unchecked, type)
+#define vec_assign_unchecked(type) _VEC_CAT(_vec_assign_unchecked, type)
+#define vec_push_unchecked(type) _VEC_CAT(_vec_push_unchecked, type)
+
+/**
+ * @internal
+ * Adds the element written past the end of a <code>vec</code> to its size. When
+ * CVEC_STATS is defined it's counted in the statistics like the checked appends.
+ */
+#ifdef CVEC_STATS
+#    define _impl_vec_advance_unchecked(vec_ptr) _impl_vec_advance((_IMPL_VEC_STRUCT_NAME *)(vec_ptr), 1)
+#else
+#    define _impl_vec_advance_unchecked(vec_ptr) ((void)++(vec_ptr)->size)
+#endif /* CVEC_STATS */
+
+#define _impl_vec_def_unchecked(type) \
+    /**
+     * @brief   Gets an element from a <code>vec</code> without any checks
+     *
+     * @param[in] vec_ptr   Pointer to a valid <code>vec</code> structure.
+     * @param[in] idx       The index of the element. Must be less than the size.
+     *
+     * @return    Pointer to the element.
+     */ \
+    static _VEC_INLINE type* _VEC_CAT(_vec_get_unchecked, type)(vec_type(type) *vec_ptr, vec_size_t idx) { \
+        return &vec_ptr->_mem[_impl_vec_wrap(vec_ptr->start + idx, vec_ptr->capacity)]; \
+    } \
+    /**
+     * @brief   Gets the first element in a non-empty <code>vec</code> without any checks
+     *
+     * @param[in] vec_ptr   Pointer to a valid <code>vec</code> structure.
+     *
+     * @return    Pointer to the first element.
+     */ \
+    static _VEC_INLINE type* _VEC_CAT(_vec_first_unchecked, type)(vec_type(type) *vec_ptr) { \
+        return &vec_ptr->_mem[vec_ptr->start]; \
+    } \
+    /**
+     * @brief   Gets the last element in a non-empty <code>vec</code> without any checks
+     *
+     * @param[in] vec_ptr   Pointer to a valid <code>vec</code> structure.
+     *
+     * @return    Pointer to the last element.
+     */ \
+    static _VEC_INLINE type* _VEC_CAT(_vec_last_unchecked, type)(vec_type(type) *vec_ptr) { \
+        return &vec_ptr->_mem[_impl_vec_wrap(vec_ptr->start + vec_ptr->size - 1, vec_ptr->capacity)]; \
+    } \
+    /**
+     * @brief   Assigns a value to an element in a <code>vec</code> without any checks
+     *
+     * @param[in] vec_ptr   Pointer to a valid <code>vec</code> structure.
+     * @param[in] idx       The index to assign the value to. Must be less than the size.
+     * @param[in] val       The value to assign.
+     */ \
+    static _VEC_INLINE void _VEC_CAT(_vec_assign_unchecked, type)(vec_type(type) *vec_ptr, vec_size_t idx, const type val) { \
+        vec_ptr->_mem[_impl_vec_wrap(vec_ptr->start + idx, vec_ptr->capacity)] = val; \
+    } \
+    /**
+     * @brief   Pushes a value to the end of a <code>vec</code> without any checks
+     *
+     * @param[in] vec_ptr   Pointer to a valid <code>vec</code> structure.
+     * @param[in] val       The value to push.
+     *
+     * @note      The <code>vec</code> must have a free slot for the value
+     *            (e.g. by calling <code>vec_reserve()</code> beforehand).
+     */ \
+    static _VEC_INLINE void _VEC_CAT(_vec_push_unchecked, type)(vec_type(type) *vec_ptr, const type val) { \
+        vec_ptr->_mem[_impl_vec_wrap(vec_ptr->start + vec_ptr->size, vec_ptr->capacity)] = val; \
+        _impl_vec_advance_unchecked(vec_ptr); \
+    }
+#else
+#define _impl_vec_def_unchecked(type)
+#endif /* CVEC_UNCHECKED_ACCESSORS */
+
+/**
+ * @internal
+ * Defines the statistics query for a <code>vec</code> of type
+ * <code>type</code> if CVEC_STATS is defined.
+ */
+#ifdef CVEC_STATS
+#define vec_stats(type) _VEC_CAT(_vec_stats, type)
+
+#define _impl_vec_def_stats(type) \
+    /**
+     * @brief   Gets the statistics counters of a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[out] stats    Pointer to store the counters in.
+     *
+     * @return    TRUE if the counters were stored. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_stats, type)(const vec_type(type) *vec_ptr, vec_statistics *stats) { \
+        return (_impl_vec_stats)((const _IMPL_VEC_STRUCT_NAME *)vec_ptr, stats); \
+    }
+#else
+#define _impl_vec_def_stats(type)
+#endif /* CVEC_STATS */
+
+/**
+ * Gets the type name of a span of contiguous elements of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the vec.
+ */
+#define vec_span_type(type) _VEC_CAT(_vec_span, type)
+
+/**
+ * Gets the type name of a slice of a <code>vec</code> of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the vec.
+ */
+#define vec_slice_type(type) _VEC_CAT(_vec_slice_type, type)
+
+/**
+ * Defines a <code>vec</code> of type <code>type</code>
+ * and its associated functionality
+ */
+#define using_vec_type(type)    \
+    _impl_vec_def_struct(type, vec_type(type)); \
+    _impl_vec_def_cmp(type, vec_cmp_type(type)); \
+    _impl_vec_def_span(type, vec_span_type(type)); \
+    _impl_vec_def_slice(type, vec_slice_type(type)); \
+    \
+    /**
+     * @brief   Initializes a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     */ \
+    static int (_VEC_CAT(_vec_init, type))(vec_type(type) *vec_ptr) { \
+        return (_impl_vec_init)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, sizeof(type)); \
+    } \
+    /**
+     * @brief   Initializes a <code>vec</code> that allocates its memory using an allocator
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] alloc     Pointer to the allocator to use. Must remain valid
+     *                      while the <code>vec</code> is in use.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     */ \
+    static int (_VEC_CAT(_vec_init_with_alloc, type))(vec_type(type) *vec_ptr, const vec_allocator *alloc) { \
+        return (_impl_vec_init_alloc)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, sizeof(type), alloc); \
+    } \
+    /**
+     * @brief   Reserves memory in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] capacity  The capacity to reserve.
+     *
+     * @note      Memory is only allocated if @p capacity exceeds the current
+     *            capacity. Otherwise this function does nothing.
+     *            The capacity is rounded up according to the granularity of
+     *            the growth policy, and when CVEC_POW2_CAPACITY is defined
+     *            to the next power of two.
+     *
+     * @return    TRUE if the reservation succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_reserve, type)(vec_type(type) *vec_ptr, vec_size_t capacity) { \
+        return (_impl_vec_reserve)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, capacity); \
+    } \
+    /**
+     * @brief   Shrinks the capacity of a <code>vec</code> to fit its size
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @note      The capacity is still rounded up according to the growth policy
+     *            and the capacity mode. An empty <code>vec</code> frees its memory.
+     *
+     * @return    TRUE if the shrinking succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_shrink_to_fit, type)(vec_type(type) *vec_ptr) { \
+        return (_impl_vec_shrink_to_fit)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    /**
+     * @brief   Sets the growth policy of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] policy    Pointer to the growth policy to use, or NULL for the default
+     *                      policy. Must remain valid while the <code>vec</code> is in use.
+     *
+     * @return    TRUE if the policy is valid. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_set_growth, type)(vec_type(type) *vec_ptr, const vec_growth_policy *policy) { \
+        return (_impl_vec_set_growth)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, policy); \
+    } \
+    /**
+     * @brief   Gets the count of elements stored in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @return    The count of elements stored in the <code>vec</code>.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_size, type)(vec_type(type) *vec_ptr) { \
+        return (_impl_vec_size)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    /**
+     * @brief   Gets the capacity of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @return    The capacity of the <code>vec</code>.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_capacity, type)(vec_type(type) *vec_ptr) { \
+        return (_impl_vec_capacity)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    /**
+     * @brief   Checks if a <code>vec</code> is empty.
+     *
+     * @return  TRUE if the <code>vec</code> is empty. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_empty, type)(vec_type(type) *vec_ptr) { \
+        return (_impl_vec_size)((_IMPL_VEC_STRUCT_NAME *)vec_ptr) == 0; \
+    } \
+    /**
+     * @brief   Gets an element from a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+     * @param[in] idx       The index of the element.
+     *
+     * @return    Pointer to the element if @p vec_ptr and @p idx are valid.
+     *            NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_get, type)(vec_type(type) *vec_ptr, vec_size_t idx) { \
+        return (type *)(_impl_vec_get)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx); \
+    } \
+    /**
+     * @brief   Gets the first element in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @return    Pointer to the first element if any. NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_first, type)(vec_type(type) *vec_ptr) { \
+        return (type *)(_impl_vec_get)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0); \
+    } \
+    /**
+     * @brief   Gets the last element in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @return    Pointer to the last element if any. NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_last, type)(vec_type(type) *vec_ptr) { \
+        return (type *)(_impl_vec_last)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    /**
+     * @brief   Gets the spans of contiguous elements that make up a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[out] spans    The spans of the elements in logical order.
+     *
+     * @return    The amount of non-empty spans (0 if the <code>vec</code> is empty or invalid,
+     *            2 if its elements circulate beyond the buffer end, 1 otherwise).
+     */ \
+    static unsigned int _VEC_CAT(_vec_segments, type)(vec_type(type) *vec_ptr, vec_span_type(type) spans[2]) { \
+        if (!(_impl_vec_slice)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0, (_impl_vec_size)((_IMPL_VEC_STRUCT_NAME *)vec_ptr), (_IMPL_VEC_SPAN_NAME *)spans)) { \
+            return 0; \
+        } \
+        return (spans[0].size != 0) + (spans[1].size != 0); \
+    } \
+    /**
+     * @brief   Gets a non-owning view of a range of elements in a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  idx      The index of the first element in the range.
+     * @param[in]  len      The amount of elements in the range.
+     * @param[out] slice    Pointer to the slice to initialize.
+     *
+     * @note      The slice is invalidated by the same calls that invalidate
+     *            the pointers returned by <code>vec_get()</code>.
+     *
+     * @return    TRUE if the range is inside the <code>vec</code>'s bounds. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_slice, type)(vec_type(type) *vec_ptr, vec_size_t idx, vec_size_t len, vec_slice_type(type) *slice) { \
+        if (!slice || !(_impl_vec_slice)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, len, (_IMPL_VEC_SPAN_NAME *)slice->seg)) { \
+            return FALSE; \
+        } \
+        slice->size = len; \
+        return TRUE; \
+    } \
+    /**
+     * @brief   Gets an element from a slice
+     *
+     * @param[in] slice     Pointer to a slice.
+     * @param[in] idx       The index of the element in the slice.
+     *
+     * @return    Pointer to the element if @p idx is inside the slice's bounds. NULL otherwise.
+     */ \
+    static _VEC_INLINE type* _VEC_CAT(_vec_slice_get, type)(const vec_slice_type(type) *slice, vec_size_t idx) { \
+        if (idx < slice->seg[0].size) { \
+            return &slice->seg[0].data[idx]; \
+        } \
+        return (idx < slice->size ? &slice->seg[1].data[idx - slice->seg[0].size] : NULL); \
+    } \
+    /**
+     * @brief   Swaps two elements in a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  first    The index of the first element.
+     * @param[in]  second   The index of the second element.
+     *
+     * @return     TRUE if the swap suceeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_swap, type)(vec_type(type) *vec_ptr, vec_size_t first, vec_size_t second) { \
+        unsigned char tmp[sizeof(type)]; \
+        return (_impl_vec_swap)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, first, second, tmp); \
+    } \
+    /**
+     * @brief   Sorts a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  cmpfn    Pointer to comparer function for type <code>type</code>.
+     *
+     * @return    TRUE if the sort succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_sort, type)(vec_type(type) *vec_ptr, vec_cmp_type(type) cmpfn) { \
+        return (_impl_vec_sort)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, (_IMPL_VEC_CMPFN_NAME)cmpfn); \
+    } \
+    /**
+     * @brief   Sorts a <code>vec</code> while keeping the order of equal elements
+     *
+     * @param[in]  vec_ptr      Pointer to a <code>vec</code> structure.
+     * @param[in]  cmpfn        Pointer to comparer function for type <code>type</code>.
+     * @param[in]  scratch_ptr  Pointer to a <code>vec</code> structure to reuse as a merge
+     *                          buffer across sorts, or NULL to allocate a temporary one.
+     *
+     * @note      Runs of already ordered elements are merged as they are, so nearly sorted
+     *            input is sorted in linear time.
+     *
+     * @return    TRUE if the sort succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_stable_sort, type)(vec_type(type) *vec_ptr, vec_cmp_type(type) cmpfn, vec_type(type) *scratch_ptr) { \
+        return (_impl_vec_stable_sort)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, (_IMPL_VEC_CMPFN_NAME)cmpfn, (_IMPL_VEC_STRUCT_NAME *)scratch_ptr); \
+    } \
+    /**
+     * @brief   Finds the first element in a sorted <code>vec</code> that is not less than a value
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  val      Pointer to the value to search for.
+     * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+     *
+     * @return    The index of the element, or the size of the <code>vec</code> if there's none.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_lower_bound, type)(const vec_type(type) *vec_ptr, const type *val, vec_cmp_type(type) cmpfn) { \
+        return (_impl_vec_lower_bound)((const _IMPL_VEC_STRUCT_NAME *)vec_ptr, val, (_IMPL_VEC_CMPFN_NAME)cmpfn); \
+    } \
+    /**
+     * @brief   Finds the first element in a sorted <code>vec</code> that is greater than a value
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  val      Pointer to the value to search for.
+     * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+     *
+     * @return    The index of the element, or the size of the <code>vec</code> if there's none.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_upper_bound, type)(const vec_type(type) *vec_ptr, const type *val, vec_cmp_type(type) cmpfn) { \
+        return (_impl_vec_upper_bound)((const _IMPL_VEC_STRUCT_NAME *)vec_ptr, val, (_IMPL_VEC_CMPFN_NAME)cmpfn); \
+    } \
+    /**
+     * @brief   Finds an element that is equal to a value in a sorted <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  val      Pointer to the value to search for.
+     * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+     *
+     * @return    Pointer to the first equal element if any. NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_bsearch, type)(vec_type(type) *vec_ptr, const type *val, vec_cmp_type(type) cmpfn) { \
+        type *elem = NULL; \
+        if (val && cmpfn) { \
+            elem = (type *)(_impl_vec_get)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, \
+                (_impl_vec_lower_bound)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, (_IMPL_VEC_CMPFN_NAME)cmpfn)); \
+        } \
+        return (elem && !cmpfn(elem, val) ? elem : NULL); \
+    } \
+    /**
+     * @brief   Inserts a value passed by a pointer into a sorted <code>vec</code>
+     *          after the elements that are equal to it
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  val      Pointer to the value to insert.
+     * @param[in]  cmpfn    Pointer to the comparer function the <code>vec</code> is sorted by.
+     *
+     * @return    TRUE if the insertion succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_insert_sorted, type)(vec_type(type) *vec_ptr, const type *val, vec_cmp_type(type) cmpfn) { \
+        return (_impl_vec_insert_sorted)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, (_IMPL_VEC_CMPFN_NAME)cmpfn); \
+    } \
+    /**
+     * @brief   Gets a pointer to the elements of a <code>vec</code> as a contiguous array
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @note      The elements are aligned first if they circulated beyond the end
+     *            of the <code>vec</code>'s buffer.
+     *
+     * @return    Pointer to the first element if any. NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_data, type)(vec_type(type) *vec_ptr) { \
+        return (type *)(_impl_vec_data)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    /**
+     * @brief   Assigns a value passed by a pointer to an element in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] idx       The index to assign the value to.
+     * @param[in] val       Pointer to the value to assign.
+     *
+     * @note      @p idx is valid only if its value is between 0 and the
+     *            <code>vec</code>'s size (inclusive).
+     *
+     * @return    TRUE if the assignment succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_assignptr, type)(vec_type(type) *vec_ptr, vec_size_t idx, const type *val) { \
+        return (_impl_vec_assign)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, val); \
+    } \
+    /**
+     * @brief   Assigns a value to an element in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] idx       The index to assign the value to.
+     * @param[in] val       The value to assign.
+     *
+     * @note      @p idx is valid only if its value is between 0 and the
+     *            <code>vec</code>'s size (inclusive).
+     *
+     * @return    TRUE if the assignment succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_assign, type)(vec_type(type) *vec_ptr, vec_size_t idx, const type val) { \
+        return (_impl_vec_assign)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, &val); \
+    } \
+    /**
+     * @brief   Pushes a value passed by a pointer to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       Pointer to the value to push.
+     *
+     * @return    TRUE if the push succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_pushptr, type)(vec_type(type) *vec_ptr, const type *val) { \
+        return (_impl_vec_push)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val); \
+    } \
+    /**
+     * @brief   Pushes an array of values to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The array to push.
+     * @param[in] len       The amount of elements from the array to push.
+     *
+     * @return    TRUE if the push succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_pusharr, type)(vec_type(type) *vec_ptr, const type *val, vec_size_t len) { \
+        return (_impl_vec_pusharr)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, len); \
+    } \
+    /**
+     * @brief   Appends an uninitialized element to the end of a <code>vec</code>
+     *          for the caller to construct in place
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @note      The returned pointer is invalidated by the same calls that invalidate
+     *            the pointers returned by <code>vec_get()</code>.
+     *
+     * @return    Pointer to the appended element if the append succeeded. NULL otherwise.
+     */ \
+    static type* _VEC_CAT(_vec_emplace_back, type)(vec_type(type) *vec_ptr) { \
+        _IMPL_VEC_SPAN_NAME spans[2]; \
+        if (!(_impl_vec_extend)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 1, spans)) { \
+            return NULL; \
+        } \
+        return (type *)spans[0].data; \
+    } \
+    /**
+     * @brief   Appends uninitialized elements to the end of a <code>vec</code>
+     *          for the caller to fill in place
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  len      The amount of elements to append.
+     * @param[out] slice    Pointer to a slice of the appended elements.
+     *
+     * @note      The slice is invalidated by the same calls that invalidate
+     *            the pointers returned by <code>vec_get()</code>.
+     *
+     * @return    TRUE if the append succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_extend_uninit, type)(vec_type(type) *vec_ptr, vec_size_t len, vec_slice_type(type) *slice) { \
+        if (!slice || !(_impl_vec_extend)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, len, (_IMPL_VEC_SPAN_NAME *)slice->seg)) { \
+            return FALSE; \
+        } \
+        slice->size = len; \
+        return TRUE; \
+    } \
+    /**
+     * @brief   Pushes a value to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The value to push.
+     *
+     * @return    TRUE if the push succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_push, type)(vec_type(type) *vec_ptr, const type val) { \
+        return (_impl_vec_push)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val); \
+    } \
+    /**
+     * @brief   Pops an array of elements from the end of a <code>vec</code>
+     *
+     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in]  len       The amount of elements to pop from the <code>vec</code>.
+     * @param[out] out       Optional pointer to store the popped elements in.
+     *
+     * @return    TRUE if the pop succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_poparr, type)(vec_type(type) *vec_ptr, vec_size_t len, type *out) { \
+        return (_impl_vec_poparr)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, len, out); \
+    } \
+    /**
+     * @brief   Pops an element from the end of a <code>vec</code>
+     *
+     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[out] out       Optional pointer to store the popped element in.
+     *
+     * @return    TRUE if the pop succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_pop, type)(vec_type(type) *vec_ptr, type *out) { \
+        return (_impl_vec_pop)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, out); \
+    } \
+    /**
+     * @brief   Shifts a value passed by a pointer to the beginning of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       Pointer to the value to shift.
+     *
+     * @return    TRUE if the shift succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_shiftptr, type)(vec_type(type) *vec_ptr, const type *val) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, 0, 1); \
+    } \
+    /**
+     * @brief   Shifts an array of values to the beginning of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The array to shift.
+     * @param[in] len       The amount of elements to shift.
+     *
+     * @return    TRUE if the shift succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_shiftarr, type)(vec_type(type) *vec_ptr, const type *val, vec_size_t len) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, 0, len); \
+    } \
+    /**
+     * @brief   Shifts a value to the beginning of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The value to shift.
+     *
+     * @return    TRUE if the shift succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_shift, type)(vec_type(type) *vec_ptr, const type val) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val, 0, 1); \
+    } \
+    /**
+     * @brief   Unshifts an array of elements from the beginning of a <code>vec</code>
+     *
+     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in]  len       The amount of elements to unshift.
+     * @param[out] out       Optional pointer to store the unshifted elements in.
+     *
+     * @return    TRUE if the unshift succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_unshiftarr, type)(vec_type(type) *vec_ptr, vec_size_t len, type *out) { \
+        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0, len, out); \
+    } \
+    /**
+     * @brief   Unshifts an element from the beginning of a <code>vec</code>
+     *
+     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[out] out       Optional pointer to store the unshifted element in.
+     *
+     * @return    TRUE if the unshift succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_unshift, type)(vec_type(type) *vec_ptr, type *out) { \
+        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, 0, 1, out); \
+    } \
+    /**
+     * @brief   Inserts an value passed by a pointer at a specific index in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       Pointer to the value to insert.
+     * @param[in] idx       The index at which to insert the value.
+     *
+     * @return    TRUE if the insertion succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_insertptr, type)(vec_type(type) *vec_ptr, const type *val, vec_size_t idx) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, idx, 1); \
+    } \
+    /**
+     * @brief   Inserts an array of values at a specific index in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The array to insert.
+     * @param[in] idx       The index at which to insert the value.
+     * @param[in] len       The amount of elements to insert.
+     *
+     * @return    TRUE if the insertion succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_insertarr, type)(vec_type(type) *vec_ptr, const type *val, vec_size_t idx, vec_size_t len) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, val, idx, len); \
+    } \
+    /**
+     * @brief   Inserts an value at a specific index in a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] val       The value to insert.
+     * @param[in] idx       The index at which to insert the value.
+     *
+     * @return    TRUE if the insertion succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_insert, type)(vec_type(type) *vec_ptr, const type val, vec_size_t idx) { \
+        return (_impl_vec_insert)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, &val, idx, 1); \
+    } \
+    /**
+     * @brief   Removes elements at a specific index from a <code>vec</code>
+     *
+     * @param[in]  vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in]  idx       The index of the element to remove.
+     * @param[in]  len       The amount of elements to remove.
+     * @param[out] out       Optional pointer to store the removed elements in.
+     *
+     * @return    TRUE if the removal succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_erase, type)(vec_type(type) *vec_ptr, vec_size_t idx, vec_size_t len, type *out) { \
+        return (_impl_vec_erase)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, idx, len, out); \
+    } \
+    /**
+     * @brief   Clears a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     *
+     * @note    This function must be called after there's no more use for
+     *          the initialized <code>vec</code>.
+     */ \
+    static void _VEC_CAT(_vec_clear, type)(vec_type(type) *vec_ptr) { \
+        (_impl_vec_clear)((_IMPL_VEC_STRUCT_NAME *)vec_ptr); \
+    } \
+    _impl_vec_def_unchecked(type) \
+    _impl_vec_def_stats(type) \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_type declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p, vec_cmp_type(type))
+
+/**
+ * Gets the type name of a <code>vec</code> of type <code>type</code> that
+ * keeps up to <code>n</code> elements inline
+ *
+ * @param[in] type  The type that is stored in the <code>vec</code>.
+ * @param[in] n     The amount of elements that fit in the inline buffer.
+ */
+#define vec_sbo_type(type, n) _VEC_CAT(_VEC_CAT(_vec_sbo, type), _VEC_CAT(_, n))
+#define vec_sbo_init(type, n) _VEC_CAT(_vec_init, vec_sbo_type(type, n))
+
+/**
+ * Defines a <code>vec</code> of type <code>type</code> that keeps up to
+ * <code>n</code> elements in a buffer embedded in its structure, and only
+ * allocates memory once it outgrows the buffer (<code>type</code> must have been
+ * declared with <code>using_vec_type</code> beforehand). The vector itself is the
+ * <code>vec</code> member of the structure, which is used with the regular
+ * <code>vec</code> functions.
+ */
+#define using_vec_type_sbo(type, n) \
+    typedef struct _VEC_CAT(_vectag, vec_sbo_type(type, n)) \
+    { \
+        vec_type(type) vec; \
+        vec_sbo        _sbo; \
+        type           _buf[n]; \
+    } vec_sbo_type(type, n); \
+    \
+    /**
+     * @brief   Initializes a <code>vec</code> with an inline buffer
+     *
+     * @param[in] sbo_ptr   Pointer to a structure that holds a <code>vec</code> and its inline buffer.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     *
+     * @note      The structure points into itself, so it must not be copied or moved
+     *            once it's initialized.
+     */ \
+    static int _VEC_CAT(_vec_init, vec_sbo_type(type, n))(vec_sbo_type(type, n) *sbo_ptr) { \
+        if (!sbo_ptr) { \
+            return FALSE; \
+        } \
+        return (_impl_vec_init_sbo)((_IMPL_VEC_STRUCT_NAME *)&sbo_ptr->vec, sizeof(type), &sbo_ptr->_sbo, sbo_ptr->_buf, n); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_type_sbo declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_sbo, vec_sbo_type(type, n))
+
+#define vec_introsort(type) _VEC_CAT(_vec_introsort, type)
+
+/**
+ * @internal
+ * The size of the partitions that are sorted using insertion sort by <code>vec_introsort</code>
+ */
+#define _VEC_INTROSORT_THRESHOLD 16
+
+/**
+ * Defines a sort function specialized for a <code>vec</code> of type <code>type</code>
+ * (which must have been declared with <code>using_vec_type</code> beforehand).
+ * <code>less_expr</code> is an expression that compares the elements pointed by
+ * <code>const type *a</code> and <code>const type *b</code>, and is true if
+ * <code>*a</code> should be ordered before <code>*b</code>. For example:
+ *
+ *     using_vec_sort(int, *a < *b);
+ */
+#define using_vec_sort(type, less_expr) \
+    static _VEC_INLINE int _VEC_CAT(_vec_introsort_less, type)(const type *a, const type *b) { \
+        return (less_expr); \
+    } \
+    static void _VEC_CAT(_vec_introsort_insertion, type)(type *first, type *last) { \
+        type *curr, *hole; \
+        type tmp; \
+        for (curr = first + 1; curr < last; ++curr) { \
+            tmp = *curr; \
+            for (hole = curr; hole > first && _VEC_CAT(_vec_introsort_less, type)(&tmp, hole - 1); --hole) { \
+                *hole = *(hole - 1); \
+            } \
+            *hole = tmp; \
+        } \
+    } \
+    static void _VEC_CAT(_vec_introsort_sift, type)(type *base, vec_size_t root, vec_size_t len) { \
+        vec_size_t child; \
+        type tmp = base[root]; \
+        while ((child = 2 * root + 1) < len) { \
+            if (child + 1 < len && _VEC_CAT(_vec_introsort_less, type)(&base[child], &base[child + 1])) { \
+                ++child; \
+            } \
+            if (!_VEC_CAT(_vec_introsort_less, type)(&tmp, &base[child])) { \
+                break; \
+            } \
+            base[root] = base[child]; \
+            root = child; \
+        } \
+        base[root] = tmp; \
+    } \
+    static void _VEC_CAT(_vec_introsort_heap, type)(type *base, vec_size_t len) { \
+        vec_size_t i; \
+        type tmp; \
+        for (i = len / 2; i-- > 0; ) { \
+            _VEC_CAT(_vec_introsort_sift, type)(base, i, len); \
+        } \
+        for (i = len - 1; i > 0; --i) { \
+            tmp = base[0], base[0] = base[i], base[i] = tmp; \
+            _VEC_CAT(_vec_introsort_sift, type)(base, 0, i); \
+        } \
+    } \
+    static void _VEC_CAT(_vec_introsort_loop, type)(type *first, type *last, unsigned int depth) { \
+        while (last - first > _VEC_INTROSORT_THRESHOLD) { \
+            type *lo = first, *hi = last - 1, *mid = first + (last - first) / 2; \
+            type pivot, tmp; \
+            /*
+             * Fall back to heap sort if the partitions are too unbalanced
+             */ \
+            if (!depth--) { \
+                _VEC_CAT(_vec_introsort_heap, type)(first, (vec_size_t)(last - first)); \
+                return; \
+            } \
+            /*
+             * Order the first, middle and last elements so they act as sentinels for the partitioning
+             */ \
+            if (_VEC_CAT(_vec_introsort_less, type)(mid, lo)) { tmp = *mid, *mid = *lo, *lo = tmp; } \
+            if (_VEC_CAT(_vec_introsort_less, type)(hi, mid)) { \
+                tmp = *hi, *hi = *mid, *mid = tmp; \
+                if (_VEC_CAT(_vec_introsort_less, type)(mid, lo)) { tmp = *mid, *mid = *lo, *lo = tmp; } \
+            } \
+            pivot = *mid; \
+            for (;;) { \
+                do { ++lo; } while (_VEC_CAT(_vec_introsort_less, type)(lo, &pivot)); \
+                do { --hi; } while (_VEC_CAT(_vec_introsort_less, type)(&pivot, hi)); \
+                if (lo >= hi) { \
+                    break; \
+                } \
+                tmp = *lo, *lo = *hi, *hi = tmp; \
+            } \
+            /*
+             * Recurse into the smaller partition and loop over the bigger one to bound the stack depth
+             */ \
+            if (hi + 1 - first < last - (hi + 1)) { \
+                _VEC_CAT(_vec_introsort_loop, type)(first, hi + 1, depth); \
+                first = hi + 1; \
+            } \
+            else { \
+                _VEC_CAT(_vec_introsort_loop, type)(hi + 1, last, depth); \
+                last = hi + 1; \
+            } \
+        } \
+        _VEC_CAT(_vec_introsort_insertion, type)(first, last); \
+    } \
+    /**
+     * @brief   Sorts a <code>vec</code> using an introsort specialized for its type
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     *
+     * @return    TRUE if the sort succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_introsort, type)(vec_type(type) *vec_ptr) { \
+        unsigned int depth = 0; \
+        vec_size_t len; \
+        if (!(_impl_vec_align)((_IMPL_VEC_STRUCT_NAME *)vec_ptr)) { \
+            return FALSE; \
+        } \
+        if (vec_ptr->size < 2) { \
+            return TRUE; \
+        } \
+        for (len = vec_ptr->size; len; len >>= 1) { \
+            depth += 2; \
+        } \
+        _VEC_CAT(_vec_introsort_loop, type)(&vec_ptr->_mem[vec_ptr->start], &vec_ptr->_mem[vec_ptr->start + vec_ptr->size], depth); \
+        return TRUE; \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_sort declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_introsort, vec_cmp_type(type))
+
+#endif /* !_GENERIC_CVEC_H_ */
@@ -0,0 +1,579 @@
+/**
+ * @file    cvec_concurrent.c
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  Concurrent containers built on the vector ring layout in ANSI C with atomic builtins.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#ifndef _WIN32
+#   define _XOPEN_SOURCE 600
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "cvec_concurrent.h"
+
+#ifdef _WIN32
+#   include <windows.h>
+#   define VEC_YIELD()  SwitchToThread()
+#else
+#   include <sched.h>
+#   define VEC_YIELD()  sched_yield()
+#endif
+
+/* ANSI C has no atomics, so the indices are accessed with the GCC atomic builtins, which
+ * follow the C11 memory model (and are supported by Clang and ICC as well) */
+#if !defined(__GNUC__)
+#   error "cvec_concurrent requires the GCC __atomic builtins"
+#endif
+
+#define VEC_LOAD_RELAXED(ptr)       __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#define VEC_LOAD_ACQUIRE(ptr)       __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define VEC_STORE_RELEASE(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define VEC_CLAIM(ptr, expected_ptr) \
+    __atomic_compare_exchange_n(ptr, expected_ptr, *(expected_ptr) + 1, TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+/* The amount of failed attempts a blocking operation spins for before yielding the processor */
+#define VEC_SPIN_COUNT              64
+
+/* The offset of the element in a slot of a multi-producer/multi-consumer queue, after its
+ * sequence number. Elements are copied in and out, so they don't need to be aligned */
+#define VEC_SLOT_ELEM               sizeof(vec_size_t)
+#define VEC_SLOT_SEQ(queue, pos)    ((vec_size_t *)((queue)->_slots + (size_t)((pos) & ((queue)->capacity - 1)) * (queue)->_stride))
+
+/* The index of a segment of a concurrent vector, and the index its elements start from */
+#define VEC_SEGMENT(vec, idx)       (_vec_log2(((idx) >> (vec)->_base_log) + 1))
+#define VEC_SEGMENT_START(vec, seg) ((((vec_size_t)1 << (seg)) - 1) << (vec)->_base_log)
+#define VEC_SEGMENT_BYTES(vec, seg) (((size_t)1 << ((seg) + (vec)->_base_log)) * (vec)->_t_size)
+
+#define VEC_BYTES(queue, count)     ((size_t)(count) * (queue)->_t_size)
+
+_impl_vec_def_spsc(unsigned char, _IMPL_VEC_SPSC_NAME);
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+static vec_size_t _vec_ceil_pow2(vec_size_t val)
+{
+    vec_size_t pow2 = 1;
+
+    while (pow2 && pow2 < val)
+    {
+        pow2 <<= 1;
+    }
+
+    return pow2;
+}
+
+static unsigned int _vec_log2(vec_size_t val)
+{
+    unsigned int log = 0, shift = sizeof(vec_size_t) * 4;
+
+    for (; shift; shift >>= 1)
+    {
+        if (val >> shift)
+        {
+            val >>= shift;
+            log += shift;
+        }
+    }
+
+    return log;
+}
+
+static void* _vec_queue_alloc(const vec_allocator *alloc, size_t size)
+{
+    return (alloc ? alloc->alloc_fn(alloc->ctx, size) : malloc(size));
+}
+
+static void _vec_queue_free(const vec_allocator *alloc, void *ptr, size_t size)
+{
+    if (alloc)
+    {
+        alloc->free_fn(alloc->ctx, ptr, size);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+static void _vec_queue_copy_in(unsigned char *mem, vec_size_t capacity, size_t t_size, vec_size_t pos, const unsigned char *val, vec_size_t len)
+{
+    /* Copy the values in up to two blocks, before and after the end of the buffer */
+    vec_size_t idx = pos & (capacity - 1), first = (len < capacity - idx ? len : capacity - idx);
+
+    memcpy(mem + (size_t)idx * t_size, val, (size_t)first * t_size);
+    memcpy(mem, val + (size_t)first * t_size, (size_t)(len - first) * t_size);
+}
+
+static void _vec_queue_copy_out(const unsigned char *mem, vec_size_t capacity, size_t t_size, vec_size_t pos, unsigned char *out, vec_size_t len)
+{
+    vec_size_t idx = pos & (capacity - 1), first = (len < capacity - idx ? len : capacity - idx);
+
+    memcpy(out, mem + (size_t)idx * t_size, (size_t)first * t_size);
+    memcpy(out + (size_t)first * t_size, mem, (size_t)(len - first) * t_size);
+}
+
+int _impl_vec_spsc_init(_IMPL_VEC_SPSC_NAME *queue_ptr, vec_size_t t_size, vec_size_t capacity, const vec_allocator *alloc)
+{
+    if (!queue_ptr || !t_size || !capacity)
+    {
+        return FALSE;
+    }
+
+    memset(queue_ptr, 0, sizeof(*queue_ptr));
+
+    /* The indices run freely and are wrapped with a mask, which stays correct when they
+     * overflow only if the capacity is a power of two */
+    if (!(capacity = _vec_ceil_pow2(capacity)) || ((size_t)capacity * t_size / capacity != (size_t)t_size))
+    {
+        return FALSE;
+    }
+
+    queue_ptr->_t_size = t_size;
+    queue_ptr->_alloc = alloc;
+
+    if (!(queue_ptr->_mem = (unsigned char *)_vec_queue_alloc(alloc, VEC_BYTES(queue_ptr, capacity))))
+    {
+        return FALSE;
+    }
+
+    queue_ptr->capacity = capacity;
+    return TRUE;
+}
+
+void _impl_vec_spsc_release(_IMPL_VEC_SPSC_NAME *queue_ptr)
+{
+    if (queue_ptr && queue_ptr->_mem)
+    {
+        _vec_queue_free(queue_ptr->_alloc, queue_ptr->_mem, VEC_BYTES(queue_ptr, queue_ptr->capacity));
+        memset(queue_ptr, 0, sizeof(*queue_ptr));
+    }
+}
+
+vec_size_t _impl_vec_spsc_push(_IMPL_VEC_SPSC_NAME *queue_ptr, const void *val, vec_size_t len)
+{
+    vec_size_t tail = 0;
+
+    if (!queue_ptr || !queue_ptr->_mem || !val || !len)
+    {
+        return 0;
+    }
+
+    /* Only the producer writes the tail, so it can be read without synchronization */
+    tail = queue_ptr->_tail;
+
+    /* Check the consumer's progress only when the cached head says there's no room */
+    if (queue_ptr->capacity - (tail - queue_ptr->_head_cache) < len)
+    {
+        queue_ptr->_head_cache = VEC_LOAD_ACQUIRE(&queue_ptr->_head);
+    }
+
+    if (queue_ptr->capacity - (tail - queue_ptr->_head_cache) < len)
+    {
+        len = queue_ptr->capacity - (tail - queue_ptr->_head_cache);
+    }
+
+    if (len)
+    {
+        _vec_queue_copy_in(queue_ptr->_mem, queue_ptr->capacity, queue_ptr->_t_size, tail, (const unsigned char *)val, len);
+
+        /* Publish the values to the consumer */
+        VEC_STORE_RELEASE(&queue_ptr->_tail, tail + len);
+    }
+
+    return len;
+}
+
+vec_size_t _impl_vec_spsc_pop(_IMPL_VEC_SPSC_NAME *queue_ptr, void *out, vec_size_t len)
+{
+    vec_size_t head = 0;
+
+    if (!queue_ptr || !queue_ptr->_mem || !out || !len)
+    {
+        return 0;
+    }
+
+    /* Only the consumer writes the head, so it can be read without synchronization */
+    head = queue_ptr->_head;
+
+    /* Check the producer's progress only when the cached tail says there aren't enough values */
+    if (queue_ptr->_tail_cache - head < len)
+    {
+        queue_ptr->_tail_cache = VEC_LOAD_ACQUIRE(&queue_ptr->_tail);
+    }
+
+    if (queue_ptr->_tail_cache - head < len)
+    {
+        len = queue_ptr->_tail_cache - head;
+    }
+
+    if (len)
+    {
+        _vec_queue_copy_out(queue_ptr->_mem, queue_ptr->capacity, queue_ptr->_t_size, head, (unsigned char *)out, len);
+
+        /* Hand the slots back to the producer */
+        VEC_STORE_RELEASE(&queue_ptr->_head, head + len);
+    }
+
+    return len;
+}
+
+vec_size_t _impl_vec_spsc_size(const _IMPL_VEC_SPSC_NAME *queue_ptr)
+{
+    vec_size_t head = 0;
+
+    if (!queue_ptr)
+    {
+        return 0;
+    }
+
+    /* Read the head first, so the tail is never behind it */
+    head = VEC_LOAD_ACQUIRE(&queue_ptr->_head);
+    return VEC_LOAD_ACQUIRE(&queue_ptr->_tail) - head;
+}
+
+int _impl_vec_mpmc_init(_IMPL_VEC_MPMC_NAME *queue_ptr, vec_size_t t_size, vec_size_t capacity, const vec_allocator *alloc)
+{
+    vec_size_t pos = 0;
+    size_t stride = 0;
+
+    if (!queue_ptr || !t_size || !capacity)
+    {
+        return FALSE;
+    }
+
+    memset(queue_ptr, 0, sizeof(*queue_ptr));
+
+    /* A slot's sequence number tells a full slot from an empty one only with at least two slots.
+     * Round the slots up so the sequence numbers that follow them stay aligned */
+    capacity = _vec_ceil_pow2(capacity < 2 ? 2 : capacity);
+    stride = (VEC_SLOT_ELEM + t_size + sizeof(vec_size_t) - 1) / sizeof(vec_size_t) * sizeof(vec_size_t);
+
+    if (!capacity || (stride < t_size) || (stride * capacity / capacity != stride))
+    {
+        return FALSE;
+    }
+
+    if (!(queue_ptr->_slots = (unsigned char *)_vec_queue_alloc(alloc, stride * capacity)))
+    {
+        return FALSE;
+    }
+
+    queue_ptr->capacity = capacity;
+    queue_ptr->_t_size = t_size;
+    queue_ptr->_stride = stride;
+    queue_ptr->_alloc = alloc;
+
+    /* The slot at position pos is ready to be pushed to when its sequence number equals pos */
+    for (pos = 0; pos < capacity; ++pos)
+    {
+        *VEC_SLOT_SEQ(queue_ptr, pos) = pos;
+    }
+
+    return TRUE;
+}
+
+void _impl_vec_mpmc_release(_IMPL_VEC_MPMC_NAME *queue_ptr)
+{
+    if (queue_ptr && queue_ptr->_slots)
+    {
+        _vec_queue_free(queue_ptr->_alloc, queue_ptr->_slots, queue_ptr->_stride * queue_ptr->capacity);
+        memset(queue_ptr, 0, sizeof(*queue_ptr));
+    }
+}
+
+int _impl_vec_mpmc_push(_IMPL_VEC_MPMC_NAME *queue_ptr, const void *val, int block)
+{
+    unsigned int spins = 0;
+    vec_size_t pos = 0, seq = 0;
+
+    if (!queue_ptr || !queue_ptr->_slots || !val)
+    {
+        return FALSE;
+    }
+
+    pos = VEC_LOAD_RELAXED(&queue_ptr->_tail);
+
+    for (;;)
+    {
+        seq = VEC_LOAD_ACQUIRE(VEC_SLOT_SEQ(queue_ptr, pos));
+
+        /* The slot is free at this position, so try to claim the position */
+        if (seq == pos)
+        {
+            if (VEC_CLAIM(&queue_ptr->_tail, &pos))
+            {
+                break;
+            }
+        }
+        /* The slot still holds the element pushed a lap ago, so the queue is full */
+        else if (pos - seq < queue_ptr->capacity)
+        {
+            if (!block)
+            {
+                return FALSE;
+            }
+
+            if (++spins >= VEC_SPIN_COUNT)
+            {
+                spins = 0;
+                VEC_YIELD();
+            }
+
+            pos = VEC_LOAD_RELAXED(&queue_ptr->_tail);
+        }
+        /* Another producer claimed the position */
+        else
+        {
+            pos = VEC_LOAD_RELAXED(&queue_ptr->_tail);
+        }
+    }
+
+    memcpy((unsigned char *)VEC_SLOT_SEQ(queue_ptr, pos) + VEC_SLOT_ELEM, val, queue_ptr->_t_size);
+
+    /* Publish the element to the consumer of this position */
+    VEC_STORE_RELEASE(VEC_SLOT_SEQ(queue_ptr, pos), pos + 1);
+    return TRUE;
+}
+
+int _impl_vec_mpmc_pop(_IMPL_VEC_MPMC_NAME *queue_ptr, void *out, int block)
+{
+    unsigned int spins = 0;
+    vec_size_t pos = 0, seq = 0;
+
+    if (!queue_ptr || !queue_ptr->_slots || !out)
+    {
+        return FALSE;
+    }
+
+    pos = VEC_LOAD_RELAXED(&queue_ptr->_head);
+
+    for (;;)
+    {
+        seq = VEC_LOAD_ACQUIRE(VEC_SLOT_SEQ(queue_ptr, pos));
+
+        /* The slot holds the element of this position, so try to claim the position */
+        if (seq == pos + 1)
+        {
+            if (VEC_CLAIM(&queue_ptr->_head, &pos))
+            {
+                break;
+            }
+        }
+        /* The slot is still waiting for the element of this position, so the queue is empty */
+        else if (pos + 1 - seq < queue_ptr->capacity)
+        {
+            if (!block)
+            {
+                return FALSE;
+            }
+
+            if (++spins >= VEC_SPIN_COUNT)
+            {
+                spins = 0;
+                VEC_YIELD();
+            }
+
+            pos = VEC_LOAD_RELAXED(&queue_ptr->_head);
+        }
+        /* Another consumer claimed the position */
+        else
+        {
+            pos = VEC_LOAD_RELAXED(&queue_ptr->_head);
+        }
+    }
+
+    memcpy(out, (unsigned char *)VEC_SLOT_SEQ(queue_ptr, pos) + VEC_SLOT_ELEM, queue_ptr->_t_size);
+
+    /* Hand the slot to the producer of the same position in the next lap */
+    VEC_STORE_RELEASE(VEC_SLOT_SEQ(queue_ptr, pos), pos + queue_ptr->capacity);
+    return TRUE;
+}
+
+vec_size_t _impl_vec_mpmc_size(const _IMPL_VEC_MPMC_NAME *queue_ptr)
+{
+    vec_size_t head = 0, tail = 0;
+
+    if (!queue_ptr)
+    {
+        return 0;
+    }
+
+    /* The head may pass a tail that was read earlier, so read it first and clamp the result */
+    head = VEC_LOAD_ACQUIRE(&queue_ptr->_head);
+    tail = VEC_LOAD_ACQUIRE(&queue_ptr->_tail);
+    return (tail - head > queue_ptr->capacity ? 0 : tail - head);
+}
+
+int _impl_vec_concurrent_init(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, vec_size_t t_size, vec_size_t first, const vec_allocator *alloc)
+{
+    if (!vec_ptr || !t_size)
+    {
+        return FALSE;
+    }
+
+    memset(vec_ptr, 0, sizeof(*vec_ptr));
+
+    if (!(first = _vec_ceil_pow2(first)))
+    {
+        return FALSE;
+    }
+
+    vec_ptr->_t_size = t_size;
+    vec_ptr->_base_log = _vec_log2(first);
+    vec_ptr->_alloc = alloc;
+    vec_ptr->_limit = (vec_size_t)-1;
+    return TRUE;
+}
+
+void _impl_vec_concurrent_release(_IMPL_VEC_CONCURRENT_NAME *vec_ptr)
+{
+    unsigned int seg = 0;
+
+    if (!vec_ptr)
+    {
+        return;
+    }
+
+    for (seg = 0; seg < _VEC_SEGMENTS; ++seg)
+    {
+        if (vec_ptr->_segments[seg])
+        {
+            _vec_queue_free(vec_ptr->_alloc, vec_ptr->_segments[seg], VEC_SEGMENT_BYTES(vec_ptr, seg));
+        }
+    }
+
+    memset(vec_ptr, 0, sizeof(*vec_ptr));
+}
+
+/* Gets the segment of the given index, allocating it if no appender did so yet */
+static unsigned char* _vec_concurrent_segment(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, unsigned int seg)
+{
+    unsigned char *mem = VEC_LOAD_ACQUIRE(&vec_ptr->_segments[seg]), *expected = NULL;
+    size_t bytes = VEC_SEGMENT_BYTES(vec_ptr, seg);
+
+    if (mem)
+    {
+        return mem;
+    }
+
+    if ((seg + vec_ptr->_base_log >= sizeof(size_t) * 8) || (bytes / vec_ptr->_t_size >> seg >> vec_ptr->_base_log != 1) ||
+        !(mem = (unsigned char *)_vec_queue_alloc(vec_ptr->_alloc, bytes)))
+    {
+        return NULL;
+    }
+
+    /* Appenders to the same new segment race to install it, and the losers use the winner's */
+    if (!__atomic_compare_exchange_n(&vec_ptr->_segments[seg], &expected, mem, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        _vec_queue_free(vec_ptr->_alloc, mem, bytes);
+        mem = expected;
+    }
+
+    return mem;
+}
+
+/* Lowers the limit to an index that can't be published, unless a lower one failed already */
+static void _vec_concurrent_fail(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, vec_size_t idx)
+{
+    vec_size_t limit = VEC_LOAD_RELAXED(&vec_ptr->_limit);
+
+    while ((idx < limit) &&
+           !__atomic_compare_exchange_n(&vec_ptr->_limit, &limit, idx, TRUE, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+void* _impl_vec_concurrent_push(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, const void *val)
+{
+    unsigned int spins = 0, seg = 0;
+    vec_size_t idx = 0;
+    unsigned char *elem = NULL;
+
+    /* Every index claimed after a failure is above the limit, so don't claim one at all */
+    if (!vec_ptr || !vec_ptr->_t_size || !val || (VEC_LOAD_ACQUIRE(&vec_ptr->_limit) != (vec_size_t)-1))
+    {
+        return NULL;
+    }
+
+    idx = __atomic_fetch_add(&vec_ptr->_claimed, 1, __ATOMIC_RELAXED);
+    seg = VEC_SEGMENT(vec_ptr, idx);
+
+    /* An index past the last segment or a failed allocation leaves a gap that can never be
+     * published, so the vector stops growing at it and every append above it fails */
+    if ((idx > (vec_size_t)-1 - ((vec_size_t)1 << vec_ptr->_base_log)) || !(elem = _vec_concurrent_segment(vec_ptr, seg)))
+    {
+        _vec_concurrent_fail(vec_ptr, idx);
+        return NULL;
+    }
+
+    elem += (size_t)(idx - VEC_SEGMENT_START(vec_ptr, seg)) * vec_ptr->_t_size;
+    memcpy(elem, val, vec_ptr->_t_size);
+
+    /* Publish the elements in order, so that every index below the size is readable. The
+     * indices below the limit are still published, as all of the indices before them are */
+    while (VEC_LOAD_ACQUIRE(&vec_ptr->_size) != idx)
+    {
+        if (idx > VEC_LOAD_ACQUIRE(&vec_ptr->_limit))
+        {
+            return NULL;
+        }
+
+        if (++spins >= VEC_SPIN_COUNT)
+        {
+            spins = 0;
+            VEC_YIELD();
+        }
+    }
+
+    VEC_STORE_RELEASE(&vec_ptr->_size, idx + 1);
+    return elem;
+}
+
+void* _impl_vec_concurrent_get(const _IMPL_VEC_CONCURRENT_NAME *vec_ptr, vec_size_t idx)
+{
+    unsigned int seg = 0;
+
+    if (!vec_ptr || idx >= VEC_LOAD_ACQUIRE(&vec_ptr->_size))
+    {
+        return NULL;
+    }
+
+    seg = VEC_SEGMENT(vec_ptr, idx);
+    return VEC_LOAD_RELAXED(&vec_ptr->_segments[seg]) + (size_t)(idx - VEC_SEGMENT_START(vec_ptr, seg)) * vec_ptr->_t_size;
+}
+
+vec_size_t _impl_vec_concurrent_size(const _IMPL_VEC_CONCURRENT_NAME *vec_ptr)
+{
+    return (vec_ptr ? VEC_LOAD_ACQUIRE(&vec_ptr->_size) : 0);
+}
+
+#ifdef __cplusplus
+} /* extern "C" { */
+#endif /* __cplusplus */
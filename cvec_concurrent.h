@@ -0,0 +1,628 @@
+/**
+ * @file    cvec_concurrent.h
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  Concurrent containers built on the vector ring layout in ANSI C with atomic builtins.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#ifndef _GENERIC_CVEC_CONCURRENT_H_
+#define _GENERIC_CVEC_CONCURRENT_H_
+
+#include "cvec.h"
+
+/****************************************************************************************
+  Internal Macro Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * The size of the padding that keeps the fields that different threads write to
+ * on separate cache lines
+ */
+#define _VEC_CACHE_LINE 64
+
+/**
+ * @internal
+ * Defines a single-producer/single-consumer queue of type <code>type</code>
+ * with the name <code>name</code>. The producer and the consumer only write to
+ * their own index, and keep a cached copy of the other one's index to avoid
+ * reading it on every operation.
+ */
+#define _impl_vec_def_spsc(type, name) \
+typedef struct _VEC_CAT(_vectag, name) \
+{ \
+    vec_size_t           capacity; \
+    vec_size_t           _t_size; \
+    type                *_mem; \
+    const vec_allocator *_alloc; \
+    unsigned char        _pad_shared[_VEC_CACHE_LINE]; \
+    vec_size_t           _head; \
+    vec_size_t           _tail_cache; \
+    unsigned char        _pad_head[_VEC_CACHE_LINE]; \
+    vec_size_t           _tail; \
+    vec_size_t           _head_cache; \
+    unsigned char        _pad_tail[_VEC_CACHE_LINE]; \
+} name
+
+/**
+ * @internal
+ * Defines the type name for the generic single-producer/single-consumer queue type
+ */
+#define _IMPL_VEC_SPSC_NAME _impl_vec_spsc
+
+/**
+ * @internal
+ * Defines the type name for the generic multi-producer/multi-consumer queue type
+ */
+#define _IMPL_VEC_MPMC_NAME _impl_vec_mpmc
+
+/**
+ * @internal
+ * Defines the type name for the generic concurrent vector type
+ */
+#define _IMPL_VEC_CONCURRENT_NAME _impl_vec_concurrent
+
+/**
+ * @internal
+ * The maximal amount of segments of a concurrent vector, which is enough for
+ * every index that <code>vec_size_t</code> can hold
+ */
+#define _VEC_SEGMENTS (sizeof(vec_size_t) * 8)
+
+/****************************************************************************************
+  Internal Type Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * Declares the generic single-producer/single-consumer queue structure
+ */
+struct _VEC_CAT(_vectag, _IMPL_VEC_SPSC_NAME);
+typedef struct _VEC_CAT(_vectag, _IMPL_VEC_SPSC_NAME) _IMPL_VEC_SPSC_NAME;
+
+/**
+ * @internal
+ * Defines the generic multi-producer/multi-consumer queue structure. Every slot holds a
+ * sequence number followed by an element. Producers and consumers claim positions by
+ * advancing the tail and the head, and the sequence number of a slot tells whether it's
+ * ready to be written or read at a given position.
+ * The slots don't live in a vec's ring buffer. A vec stores its elements back to back,
+ * while here every element needs its own sequence number right next to it, so the slots
+ * are strided arrays allocated through the same allocators. The ring's start and size
+ * can't be used either, since producers and consumers update them without a common lock.
+ */
+typedef struct _VEC_CAT(_vectag, _IMPL_VEC_MPMC_NAME)
+{
+    vec_size_t           capacity;
+    vec_size_t           _t_size;
+    size_t               _stride;
+    unsigned char       *_slots;
+    const vec_allocator *_alloc;
+    unsigned char        _pad_shared[_VEC_CACHE_LINE];
+    vec_size_t           _tail;
+    unsigned char        _pad_tail[_VEC_CACHE_LINE];
+    vec_size_t           _head;
+    unsigned char        _pad_head[_VEC_CACHE_LINE];
+} _IMPL_VEC_MPMC_NAME;
+
+/**
+ * @internal
+ * Defines the generic concurrent vector structure. The elements are stored in segments
+ * that double in size and are never moved once allocated. Appenders claim indices by
+ * advancing <code>_claimed</code>, and publish them in order by advancing <code>_size</code>.
+ * <code>_limit</code> is the lowest index that failed to be appended, above which no index
+ * can be published.
+ */
+typedef struct _VEC_CAT(_vectag, _IMPL_VEC_CONCURRENT_NAME)
+{
+    vec_size_t           _t_size;
+    unsigned int         _base_log;
+    const vec_allocator *_alloc;
+    unsigned char       *_segments[_VEC_SEGMENTS];
+    unsigned char        _pad_shared[_VEC_CACHE_LINE];
+    vec_size_t           _claimed;
+    unsigned char        _pad_claimed[_VEC_CACHE_LINE];
+    vec_size_t           _size;
+    vec_size_t           _limit;
+    unsigned char        _pad_size[_VEC_CACHE_LINE];
+} _IMPL_VEC_CONCURRENT_NAME;
+
+/****************************************************************************************
+  Internal Function Declarations
+ ***************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @internal
+ * @brief   Initializes a single-producer/single-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ * @param[in] t_size    The size of the type that the queue is going to hold.
+ * @param[in] capacity  The amount of elements the queue can hold. Rounded up to a power of two.
+ * @param[in] alloc     Pointer to the allocator to allocate the queue's memory with, or NULL.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_spsc_init)(_IMPL_VEC_SPSC_NAME *queue_ptr, vec_size_t t_size, vec_size_t capacity, const vec_allocator *alloc);
+
+/**
+ * @internal
+ * @brief   Releases the memory of a single-producer/single-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ */
+extern void (_impl_vec_spsc_release)(_IMPL_VEC_SPSC_NAME *queue_ptr);
+
+/**
+ * @internal
+ * @brief   Pushes values to the end of a single-producer/single-consumer queue without blocking
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ * @param[in] val       The array of values to push.
+ * @param[in] len       The maximal amount of values to push.
+ *
+ * @note      May only be called by the producer thread.
+ *
+ * @return    The amount of values that were pushed, which is less than @p len if the queue filled up.
+ */
+extern vec_size_t (_impl_vec_spsc_push)(_IMPL_VEC_SPSC_NAME *queue_ptr, const void *val, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Pops values from the beginning of a single-producer/single-consumer queue without blocking
+ *
+ * @param[in]  queue_ptr    Pointer to a generic queue structure.
+ * @param[out] out          The array to store the values in.
+ * @param[in]  len          The maximal amount of values to pop.
+ *
+ * @note       May only be called by the consumer thread.
+ *
+ * @return     The amount of values that were popped, which is less than @p len if the queue emptied.
+ */
+extern vec_size_t (_impl_vec_spsc_pop)(_IMPL_VEC_SPSC_NAME *queue_ptr, void *out, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Gets the amount of values in a single-producer/single-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ *
+ * @note      The amount may already be stale when it's returned, unless it's
+ *            called by the producer or the consumer and the other one is idle.
+ *
+ * @return    The amount of values in the queue.
+ */
+extern vec_size_t (_impl_vec_spsc_size)(const _IMPL_VEC_SPSC_NAME *queue_ptr);
+
+/**
+ * @internal
+ * @brief   Initializes a multi-producer/multi-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ * @param[in] t_size    The size of the type that the queue is going to hold.
+ * @param[in] capacity  The amount of elements the queue can hold. Rounded up to a power of two
+ *                      that is at least 2.
+ * @param[in] alloc     Pointer to the allocator to allocate the queue's memory with, or NULL.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_mpmc_init)(_IMPL_VEC_MPMC_NAME *queue_ptr, vec_size_t t_size, vec_size_t capacity, const vec_allocator *alloc);
+
+/**
+ * @internal
+ * @brief   Releases the memory of a multi-producer/multi-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ */
+extern void (_impl_vec_mpmc_release)(_IMPL_VEC_MPMC_NAME *queue_ptr);
+
+/**
+ * @internal
+ * @brief   Pushes a value to the end of a multi-producer/multi-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ * @param[in] val       Pointer to the value to push.
+ * @param[in] block     Whether to wait for room if the queue is full.
+ *
+ * @return    TRUE if the value was pushed. FALSE otherwise.
+ */
+extern int (_impl_vec_mpmc_push)(_IMPL_VEC_MPMC_NAME *queue_ptr, const void *val, int block);
+
+/**
+ * @internal
+ * @brief   Pops a value from the beginning of a multi-producer/multi-consumer queue
+ *
+ * @param[in]  queue_ptr    Pointer to a generic queue structure.
+ * @param[out] out          Pointer to store the value in.
+ * @param[in]  block        Whether to wait for a value if the queue is empty.
+ *
+ * @return     TRUE if a value was popped. FALSE otherwise.
+ */
+extern int (_impl_vec_mpmc_pop)(_IMPL_VEC_MPMC_NAME *queue_ptr, void *out, int block);
+
+/**
+ * @internal
+ * @brief   Gets the approximate amount of values in a multi-producer/multi-consumer queue
+ *
+ * @param[in] queue_ptr Pointer to a generic queue structure.
+ *
+ * @return    The amount of values in the queue at some point during the call.
+ */
+extern vec_size_t (_impl_vec_mpmc_size)(const _IMPL_VEC_MPMC_NAME *queue_ptr);
+
+/**
+ * @internal
+ * @brief   Initializes a concurrent vector
+ *
+ * @param[in] vec_ptr   Pointer to a generic concurrent vector structure.
+ * @param[in] t_size    The size of the type that the vector is going to hold.
+ * @param[in] first     The capacity of the first segment. Rounded up to a power of two.
+ * @param[in] alloc     Pointer to the allocator to allocate the segments with, or NULL.
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_concurrent_init)(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, vec_size_t t_size, vec_size_t first, const vec_allocator *alloc);
+
+/**
+ * @internal
+ * @brief   Releases the segments of a concurrent vector
+ *
+ * @param[in] vec_ptr   Pointer to a generic concurrent vector structure.
+ */
+extern void (_impl_vec_concurrent_release)(_IMPL_VEC_CONCURRENT_NAME *vec_ptr);
+
+/**
+ * @internal
+ * @brief   Appends a value to the end of a concurrent vector
+ *
+ * @param[in] vec_ptr   Pointer to a generic concurrent vector structure.
+ * @param[in] val       Pointer to the value to append.
+ *
+ * @return    A pointer to the appended element, which stays valid until the vector is released,
+ *            or NULL if the value couldn't be appended.
+ */
+extern void* (_impl_vec_concurrent_push)(_IMPL_VEC_CONCURRENT_NAME *vec_ptr, const void *val);
+
+/**
+ * @internal
+ * @brief   Gets a published element of a concurrent vector
+ *
+ * @param[in] vec_ptr   Pointer to a generic concurrent vector structure.
+ * @param[in] idx       The index of the element.
+ *
+ * @return    A pointer to the element, or NULL if it hasn't been published.
+ */
+extern void* (_impl_vec_concurrent_get)(const _IMPL_VEC_CONCURRENT_NAME *vec_ptr, vec_size_t idx);
+
+/**
+ * @internal
+ * @brief   Gets the amount of published elements of a concurrent vector
+ *
+ * @param[in] vec_ptr   Pointer to a generic concurrent vector structure.
+ *
+ * @return    The amount of elements that were published by the time of the call.
+ */
+extern vec_size_t (_impl_vec_concurrent_size)(const _IMPL_VEC_CONCURRENT_NAME *vec_ptr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/****************************************************************************************
+  External Macro Definitions
+ ***************************************************************************************/
+#define vec_spsc_init(type) _VEC_CAT(_vec_spsc_init, type)
+#define vec_spsc_release(type) _VEC_CAT(_vec_spsc_release, type)
+#define vec_spsc_try_push(type) _VEC_CAT(_vec_spsc_try_push, type)
+#define vec_spsc_try_pop(type) _VEC_CAT(_vec_spsc_try_pop, type)
+#define vec_spsc_push_batch(type) _VEC_CAT(_vec_spsc_push_batch, type)
+#define vec_spsc_pop_batch(type) _VEC_CAT(_vec_spsc_pop_batch, type)
+#define vec_spsc_size(type) _VEC_CAT(_vec_spsc_size, type)
+#define vec_mpmc_init(type) _VEC_CAT(_vec_mpmc_init, type)
+#define vec_mpmc_release(type) _VEC_CAT(_vec_mpmc_release, type)
+#define vec_mpmc_push(type) _VEC_CAT(_vec_mpmc_push, type)
+#define vec_mpmc_pop(type) _VEC_CAT(_vec_mpmc_pop, type)
+#define vec_mpmc_try_push(type) _VEC_CAT(_vec_mpmc_try_push, type)
+#define vec_mpmc_try_pop(type) _VEC_CAT(_vec_mpmc_try_pop, type)
+#define vec_mpmc_size(type) _VEC_CAT(_vec_mpmc_size, type)
+#define vec_concurrent_init(type) _VEC_CAT(_vec_concurrent_init, type)
+#define vec_concurrent_release(type) _VEC_CAT(_vec_concurrent_release, type)
+#define vec_concurrent_push(type) _VEC_CAT(_vec_concurrent_push, type)
+#define vec_concurrent_get(type) _VEC_CAT(_vec_concurrent_get, type)
+#define vec_concurrent_size(type) _VEC_CAT(_vec_concurrent_size, type)
+
+/**
+ * Gets the type name of a single-producer/single-consumer queue of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the queue.
+ */
+#define vec_spsc_type(type) _VEC_CAT(_vec_spsc, type)
+
+/**
+ * Gets the type name of a multi-producer/multi-consumer queue of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the queue.
+ */
+#define vec_mpmc_type(type) _VEC_CAT(_vec_mpmc, type)
+
+/**
+ * Gets the type name of a concurrent vector of type <code>type</code>
+ *
+ * @param[in] type  The type that is stored in the vector.
+ */
+#define vec_concurrent_type(type) _VEC_CAT(_vec_concurrent, type)
+
+/**
+ * Defines a single-producer/single-consumer queue of type <code>type</code>
+ * and its associated functionality (<code>type</code> must have been declared
+ * with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_spsc(type) \
+    _impl_vec_def_spsc(type, vec_spsc_type(type)); \
+    \
+    /**
+     * @brief   Initializes a single-producer/single-consumer queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] capacity  The amount of elements the queue can hold. Rounded up to a power of two.
+     * @param[in] alloc     Pointer to the allocator to allocate the queue's memory with, or NULL.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_spsc_init, type)(vec_spsc_type(type) *queue_ptr, vec_size_t capacity, const vec_allocator *alloc) { \
+        return (_impl_vec_spsc_init)((_IMPL_VEC_SPSC_NAME *)queue_ptr, sizeof(type), capacity, alloc); \
+    } \
+    /**
+     * @brief   Releases the memory of a single-producer/single-consumer queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     */ \
+    static void _VEC_CAT(_vec_spsc_release, type)(vec_spsc_type(type) *queue_ptr) { \
+        (_impl_vec_spsc_release)((_IMPL_VEC_SPSC_NAME *)queue_ptr); \
+    } \
+    /**
+     * @brief   Pushes a value passed by a pointer to the end of a queue without blocking.
+     *          May only be called by the producer thread.
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] val       Pointer to the value to push.
+     *
+     * @return    TRUE if the value was pushed. FALSE if the queue is full.
+     */ \
+    static int _VEC_CAT(_vec_spsc_try_push, type)(vec_spsc_type(type) *queue_ptr, const type *val) { \
+        return (_impl_vec_spsc_push)((_IMPL_VEC_SPSC_NAME *)queue_ptr, val, 1) != 0; \
+    } \
+    /**
+     * @brief   Pops a value from the beginning of a queue without blocking.
+     *          May only be called by the consumer thread.
+     *
+     * @param[in]  queue_ptr    Pointer to a queue structure.
+     * @param[out] out          Pointer to store the value in.
+     *
+     * @return    TRUE if a value was popped. FALSE if the queue is empty.
+     */ \
+    static int _VEC_CAT(_vec_spsc_try_pop, type)(vec_spsc_type(type) *queue_ptr, type *out) { \
+        return (_impl_vec_spsc_pop)((_IMPL_VEC_SPSC_NAME *)queue_ptr, out, 1) != 0; \
+    } \
+    /**
+     * @brief   Pushes as many values of an array as there's room for to the end of a queue
+     *          without blocking. May only be called by the producer thread.
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] val       The array of values to push.
+     * @param[in] len       The amount of values in the array.
+     *
+     * @return    The amount of values that were pushed.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_spsc_push_batch, type)(vec_spsc_type(type) *queue_ptr, const type *val, vec_size_t len) { \
+        return (_impl_vec_spsc_push)((_IMPL_VEC_SPSC_NAME *)queue_ptr, val, len); \
+    } \
+    /**
+     * @brief   Pops up to a given amount of values from the beginning of a queue without
+     *          blocking. May only be called by the consumer thread.
+     *
+     * @param[in]  queue_ptr    Pointer to a queue structure.
+     * @param[out] out          The array to store the values in.
+     * @param[in]  len          The maximal amount of values to pop.
+     *
+     * @return    The amount of values that were popped.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_spsc_pop_batch, type)(vec_spsc_type(type) *queue_ptr, type *out, vec_size_t len) { \
+        return (_impl_vec_spsc_pop)((_IMPL_VEC_SPSC_NAME *)queue_ptr, out, len); \
+    } \
+    /**
+     * @brief   Gets the amount of values in a queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     *
+     * @return    The amount of values in the queue.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_spsc_size, type)(const vec_spsc_type(type) *queue_ptr) { \
+        return (_impl_vec_spsc_size)((const _IMPL_VEC_SPSC_NAME *)queue_ptr); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_spsc declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_spsc, vec_cmp_type(type))
+
+/**
+ * Defines a multi-producer/multi-consumer queue of type <code>type</code>
+ * and its associated functionality (<code>type</code> must have been declared
+ * with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_mpmc(type) \
+    typedef _IMPL_VEC_MPMC_NAME vec_mpmc_type(type); \
+    \
+    /**
+     * @brief   Initializes a multi-producer/multi-consumer queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] capacity  The amount of elements the queue can hold. Rounded up to a power
+     *                      of two that is at least 2.
+     * @param[in] alloc     Pointer to the allocator to allocate the queue's memory with, or NULL.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_mpmc_init, type)(vec_mpmc_type(type) *queue_ptr, vec_size_t capacity, const vec_allocator *alloc) { \
+        return (_impl_vec_mpmc_init)(queue_ptr, sizeof(type), capacity, alloc); \
+    } \
+    /**
+     * @brief   Releases the memory of a multi-producer/multi-consumer queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     */ \
+    static void _VEC_CAT(_vec_mpmc_release, type)(vec_mpmc_type(type) *queue_ptr) { \
+        (_impl_vec_mpmc_release)(queue_ptr); \
+    } \
+    /**
+     * @brief   Pushes a value passed by a pointer to the end of a queue,
+     *          waiting for room if the queue is full
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] val       Pointer to the value to push.
+     *
+     * @return    TRUE if the value was pushed. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_mpmc_push, type)(vec_mpmc_type(type) *queue_ptr, const type *val) { \
+        return (_impl_vec_mpmc_push)(queue_ptr, val, TRUE); \
+    } \
+    /**
+     * @brief   Pops a value from the beginning of a queue, waiting for one if the queue is empty
+     *
+     * @param[in]  queue_ptr    Pointer to a queue structure.
+     * @param[out] out          Pointer to store the value in.
+     *
+     * @return    TRUE if a value was popped. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_mpmc_pop, type)(vec_mpmc_type(type) *queue_ptr, type *out) { \
+        return (_impl_vec_mpmc_pop)(queue_ptr, out, TRUE); \
+    } \
+    /**
+     * @brief   Pushes a value passed by a pointer to the end of a queue without blocking
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     * @param[in] val       Pointer to the value to push.
+     *
+     * @return    TRUE if the value was pushed. FALSE if the queue is full.
+     */ \
+    static int _VEC_CAT(_vec_mpmc_try_push, type)(vec_mpmc_type(type) *queue_ptr, const type *val) { \
+        return (_impl_vec_mpmc_push)(queue_ptr, val, FALSE); \
+    } \
+    /**
+     * @brief   Pops a value from the beginning of a queue without blocking
+     *
+     * @param[in]  queue_ptr    Pointer to a queue structure.
+     * @param[out] out          Pointer to store the value in.
+     *
+     * @return    TRUE if a value was popped. FALSE if the queue is empty.
+     */ \
+    static int _VEC_CAT(_vec_mpmc_try_pop, type)(vec_mpmc_type(type) *queue_ptr, type *out) { \
+        return (_impl_vec_mpmc_pop)(queue_ptr, out, FALSE); \
+    } \
+    /**
+     * @brief   Gets the approximate amount of values in a queue
+     *
+     * @param[in] queue_ptr Pointer to a queue structure.
+     *
+     * @return    The amount of values in the queue.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_mpmc_size, type)(const vec_mpmc_type(type) *queue_ptr) { \
+        return (_impl_vec_mpmc_size)(queue_ptr); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_mpmc declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_mpmc, vec_cmp_type(type))
+
+/**
+ * Defines an append-only concurrent vector of type <code>type</code>
+ * and its associated functionality (<code>type</code> must have been declared
+ * with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_concurrent(type) \
+    typedef _IMPL_VEC_CONCURRENT_NAME vec_concurrent_type(type); \
+    \
+    /**
+     * @brief   Initializes a concurrent vector
+     *
+     * @param[in] vec_ptr   Pointer to a concurrent vector structure.
+     * @param[in] first     The capacity of the first segment. Rounded up to a power of two.
+     * @param[in] alloc     Pointer to the allocator to allocate the segments with, or NULL.
+     *
+     * @return    TRUE if the initialization succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_concurrent_init, type)(vec_concurrent_type(type) *vec_ptr, vec_size_t first, const vec_allocator *alloc) { \
+        return (_impl_vec_concurrent_init)(vec_ptr, sizeof(type), first, alloc); \
+    } \
+    /**
+     * @brief   Releases the segments of a concurrent vector
+     *
+     * @param[in] vec_ptr   Pointer to a concurrent vector structure.
+     */ \
+    static void _VEC_CAT(_vec_concurrent_release, type)(vec_concurrent_type(type) *vec_ptr) { \
+        (_impl_vec_concurrent_release)(vec_ptr); \
+    } \
+    /**
+     * @brief   Appends a value passed by a pointer to the end of a concurrent vector
+     *
+     * @param[in] vec_ptr   Pointer to a concurrent vector structure.
+     * @param[in] val       Pointer to the value to append.
+     *
+     * @return    A pointer to the appended element, which stays valid until the vector is
+     *            released, or NULL if the value couldn't be appended.
+     */ \
+    static type* _VEC_CAT(_vec_concurrent_push, type)(vec_concurrent_type(type) *vec_ptr, const type *val) { \
+        return (type *)(_impl_vec_concurrent_push)(vec_ptr, val); \
+    } \
+    /**
+     * @brief   Gets a published element of a concurrent vector
+     *
+     * @param[in] vec_ptr   Pointer to a concurrent vector structure.
+     * @param[in] idx       The index of the element.
+     *
+     * @return    A pointer to the element, or NULL if it hasn't been published.
+     */ \
+    static type* _VEC_CAT(_vec_concurrent_get, type)(const vec_concurrent_type(type) *vec_ptr, vec_size_t idx) { \
+        return (type *)(_impl_vec_concurrent_get)(vec_ptr, idx); \
+    } \
+    /**
+     * @brief   Gets the amount of published elements of a concurrent vector
+     *
+     * @param[in] vec_ptr   Pointer to a concurrent vector structure.
+     *
+     * @return    The amount of elements that were published by the time of the call.
+     */ \
+    static vec_size_t _VEC_CAT(_vec_concurrent_size, type)(const vec_concurrent_type(type) *vec_ptr) { \
+        return (_impl_vec_concurrent_size)(vec_ptr); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_concurrent declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_concurrent, vec_cmp_type(type))
+
+#endif /* !_GENERIC_CVEC_CONCURRENT_H_ */
@@ -0,0 +1,796 @@
+/**
+ * @file    cvec_io.c
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  File descriptor I/O for byte vectors in ANSI C with POSIX scatter/gather I/O.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "cvec_io.h"
+
+_impl_vec_def_struct(unsigned char, _IMPL_VEC_STRUCT_NAME);
+
+/* The header at the beginning of a mapped file. The elements start at a page boundary after it */
+typedef struct _vec_mapped_header
+{
+    char         magic[8];
+    unsigned int size_width;
+    unsigned int pow2_capacity;
+    vec_size_t   t_size;
+    vec_size_t   start;
+    vec_size_t   size;
+    vec_size_t   capacity;
+    size_t       data_offset;
+} _vec_mapped_header;
+
+#define VEC_MAPPED_MAGIC        "cvec map"
+#define VEC_ROUND_UP(size, to)  (((size) + (to) - 1) / (to) * (to))
+
+/* The layout of a snapshot header. The fields are little endian, and the byte order of the
+ * elements is marked since they're written as they are in memory */
+#define VEC_SNAPSHOT_MAGIC      "cvecsnap"
+#define VEC_SNAPSHOT_VERSION    1
+#define VEC_SNAPSHOT_LITTLE     1
+#define VEC_SNAPSHOT_BIG        2
+#define VEC_SNAPSHOT_HEADER     32
+#define VEC_SNAPSHOT_CHUNK      (1024 * 1024)
+
+/* The largest amount of bytes that can be added to the sums of Adler-32 before reducing them */
+#define VEC_ADLER_BASE          65521UL
+#define VEC_ADLER_NMAX          5552
+
+#ifdef CVEC_POW2_CAPACITY
+#   define VEC_POW2_CAPACITY    TRUE
+#else
+#   define VEC_POW2_CAPACITY    FALSE
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+ssize_t _impl_vec_read_fd(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd, vec_size_t len)
+{
+    struct iovec iov[2];
+    vec_size_t tail;
+    ssize_t count;
+
+    if (!vec_ptr || vec_ptr->_t_size != 1 || !len)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (!_impl_vec_grow(vec_ptr, len))
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /* The free space is contiguous up to the start of the elements if they circulated
+     * beyond the end of the buffer, and wraps around to its beginning otherwise */
+    tail = _impl_vec_wrap(vec_ptr->start + vec_ptr->size, vec_ptr->capacity);
+    iov[0].iov_base = &vec_ptr->_mem[tail];
+    iov[0].iov_len = len < vec_ptr->capacity - tail ? len : vec_ptr->capacity - tail;
+    iov[1].iov_base = vec_ptr->_mem;
+    iov[1].iov_len = len - iov[0].iov_len;
+
+    count = readv(fd, iov, iov[1].iov_len ? 2 : 1);
+    if (count > 0)
+    {
+        _impl_vec_advance(vec_ptr, (vec_size_t)count);
+    }
+
+    return count;
+}
+
+ssize_t _impl_vec_write_fd(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd)
+{
+    _IMPL_VEC_SPAN_NAME spans[2];
+    struct iovec iov[2];
+    ssize_t count;
+
+    if (!vec_ptr || vec_ptr->_t_size != 1 ||
+        !_impl_vec_slice(vec_ptr, 0, vec_ptr->size, spans))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (!spans[0].size)
+    {
+        return 0;
+    }
+
+    iov[0].iov_base = spans[0].data;
+    iov[0].iov_len = spans[0].size;
+    iov[1].iov_base = spans[1].data;
+    iov[1].iov_len = spans[1].size;
+
+    count = writev(fd, iov, spans[1].size ? 2 : 1);
+    if (count > 0)
+    {
+        /* Consuming from the front only advances the start of the ring */
+        _impl_vec_erase(vec_ptr, 0, (vec_size_t)count, NULL);
+    }
+
+    return count;
+}
+
+static struct _vec_mapped_region* _vec_mapped_find(vec_mapped *mapped, const void *ptr)
+{
+    unsigned int i;
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (mapped->_regions[i].mem == ptr)
+        {
+            return &mapped->_regions[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Gets the offset in the file right after the last mapped region (or after the header) */
+static size_t _vec_mapped_end(const vec_mapped *mapped)
+{
+    size_t end = mapped->_page;
+    unsigned int i;
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (mapped->_regions[i].mem && mapped->_regions[i].offset + mapped->_regions[i].size > end)
+        {
+            end = mapped->_regions[i].offset + mapped->_regions[i].size;
+        }
+    }
+
+    return end;
+}
+
+static void* _vec_mapped_alloc(void *ctx, size_t size)
+{
+    vec_mapped *mapped = (vec_mapped *)ctx;
+    struct _vec_mapped_region *region = _vec_mapped_find(mapped, NULL), *other = NULL;
+    size_t end = _vec_mapped_end(mapped), offset = mapped->_page;
+    void *mem;
+
+    if ((!region) || (!size))
+    {
+        return NULL;
+    }
+
+    /* Map the new region right after the header if it fits below the other one, so the space
+     * that a moved buffer left behind is reused. Otherwise map it after the other one */
+    other = (region == &mapped->_regions[0] ? &mapped->_regions[1] : &mapped->_regions[0]);
+    if ((other->mem) && (size > other->offset - mapped->_page))
+    {
+        offset = VEC_ROUND_UP(end, mapped->_page);
+    }
+
+    /* Extend the file to fit the region */
+    if ((offset + size < offset) || ((offset + size > end) && (ftruncate(mapped->_fd, (off_t)(offset + size)))))
+    {
+        return NULL;
+    }
+
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->_fd, (off_t)offset);
+    if (mem == MAP_FAILED)
+    {
+        (void)ftruncate(mapped->_fd, (off_t)_vec_mapped_end(mapped));
+        return NULL;
+    }
+
+    region->mem = (unsigned char *)mem;
+    region->offset = offset;
+    region->size = size;
+
+    return mem;
+}
+
+static void _vec_mapped_free(void *ctx, void *ptr, size_t size)
+{
+    vec_mapped *mapped = (vec_mapped *)ctx;
+    struct _vec_mapped_region *region = _vec_mapped_find(mapped, ptr);
+
+    if (region)
+    {
+        munmap(region->mem, region->size);
+        region->mem = NULL;
+
+        /* Give back the space at the end of the file that is no longer mapped */
+        (void)ftruncate(mapped->_fd, (off_t)_vec_mapped_end(mapped));
+    }
+
+    (void)size;
+}
+
+/* Moves the only mapped region to the front of the file, right after the header */
+static void* _vec_mapped_compact(vec_mapped *mapped, struct _vec_mapped_region *region, size_t size)
+{
+    size_t gap = region->offset - mapped->_page, done = 0, len = 0;
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->_fd, (off_t)mapped->_page);
+
+    if (mem == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    /* Both ranges overlap in the file if the gap between them is smaller than the region, so
+     * the bytes are copied forwards a gap at a time, each from beyond the bytes written so far */
+    for (done = 0; done < size; done += len)
+    {
+        len = (size - done < gap ? size - done : gap);
+        memcpy((unsigned char *)mem + done, region->mem + done, len);
+    }
+
+    munmap(region->mem, region->size);
+    region->mem = (unsigned char *)mem;
+    region->offset = mapped->_page;
+    region->size = size;
+    (void)ftruncate(mapped->_fd, (off_t)_vec_mapped_end(mapped));
+
+    return mem;
+}
+
+static void* _vec_mapped_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    vec_mapped *mapped = (vec_mapped *)ctx;
+    struct _vec_mapped_region *region = _vec_mapped_find(mapped, ptr);
+    void *mem;
+
+    if ((!region) || (!new_size))
+    {
+        return NULL;
+    }
+
+    /* A region that isn't the last one in the file can't grow in place */
+    if (region->offset + region->size != _vec_mapped_end(mapped))
+    {
+        if ((mem = _vec_mapped_alloc(ctx, new_size)))
+        {
+            memcpy(mem, ptr, (old_size < new_size ? old_size : new_size));
+            _vec_mapped_free(ctx, ptr, old_size);
+        }
+
+        return mem;
+    }
+
+    /* The only region, if a move left it beyond the header, is moved back to the front of the
+     * file when it shrinks, so the file doesn't keep the space in front of it */
+    if ((new_size < region->size) && (region->offset > mapped->_page) && (_vec_mapped_find(mapped, NULL)) &&
+        ((mem = _vec_mapped_compact(mapped, region, new_size))))
+    {
+        return mem;
+    }
+
+    if ((new_size > region->size) && (ftruncate(mapped->_fd, (off_t)(region->offset + new_size))))
+    {
+        return NULL;
+    }
+
+    /* Map the resized region before unmapping the old one, so the old one remains valid on failure.
+     * Both map the same pages of the file, so the elements don't need to be copied */
+    mem = mmap(NULL, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->_fd, (off_t)region->offset);
+    if (mem == MAP_FAILED)
+    {
+        (void)ftruncate(mapped->_fd, (off_t)_vec_mapped_end(mapped));
+        return NULL;
+    }
+
+    munmap(region->mem, region->size);
+    region->mem = (unsigned char *)mem;
+    region->size = new_size;
+    (void)ftruncate(mapped->_fd, (off_t)_vec_mapped_end(mapped));
+
+    return mem;
+}
+
+/* Validates the header of an existing file and maps the elements it describes */
+static int _vec_mapped_load(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_mapped *mapped, off_t file_size)
+{
+    const _vec_mapped_header *header = (const _vec_mapped_header *)mapped->_header;
+    size_t bytes = (size_t)header->capacity * header->t_size;
+    void *mem;
+
+    if (memcmp(header->magic, VEC_MAPPED_MAGIC, sizeof(header->magic)) ||
+        (header->size_width != sizeof(vec_size_t)) || (header->pow2_capacity != VEC_POW2_CAPACITY) ||
+        (header->t_size != vec_ptr->_t_size) || (bytes / header->t_size != header->capacity) ||
+        (header->data_offset % mapped->_page) || (header->data_offset < mapped->_page) ||
+        (header->data_offset + bytes < bytes) || ((off_t)(header->data_offset + bytes) > file_size) ||
+        (header->size > header->capacity) || (header->capacity && header->start >= header->capacity))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    if (!header->capacity)
+    {
+        return TRUE;
+    }
+
+    mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->_fd, (off_t)header->data_offset);
+    if (mem == MAP_FAILED)
+    {
+        return FALSE;
+    }
+
+    mapped->_regions[0].mem = (unsigned char *)mem;
+    mapped->_regions[0].offset = header->data_offset;
+    mapped->_regions[0].size = bytes;
+
+    vec_ptr->_mem = (unsigned char *)mem;
+    vec_ptr->start = header->start;
+    vec_ptr->capacity = header->capacity;
+    _impl_vec_advance(vec_ptr, header->size);
+
+    return TRUE;
+}
+
+int _impl_vec_open_mapped(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, vec_mapped *mapped, const char *path, int flags)
+{
+    struct stat st;
+    long page = sysconf(_SC_PAGESIZE);
+    int err;
+
+    if (!vec_ptr || !mapped || !path || (page <= 0) || ((size_t)page < sizeof(_vec_mapped_header)))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    memset(mapped, 0, sizeof(*mapped));
+    mapped->allocator.alloc_fn = _vec_mapped_alloc;
+    mapped->allocator.realloc_fn = _vec_mapped_realloc;
+    mapped->allocator.free_fn = _vec_mapped_free;
+    mapped->allocator.ctx = mapped;
+    mapped->allocator.file_backed = TRUE;
+    mapped->_page = (size_t)page;
+
+    if (!_impl_vec_init_alloc(vec_ptr, t_size, &mapped->allocator))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    mapped->_fd = open(path, O_RDWR | ((flags & VEC_MAPPED_CREATE) ? O_CREAT : 0) |
+                       ((flags & VEC_MAPPED_TRUNCATE) ? O_TRUNC : 0), 0666);
+    if (mapped->_fd < 0)
+    {
+        return FALSE;
+    }
+
+    /* A new file only gets its header, and its elements are mapped once the vec grows */
+    if (fstat(mapped->_fd, &st) || (!st.st_size && ftruncate(mapped->_fd, (off_t)mapped->_page)))
+    {
+        goto fail;
+    }
+
+    mapped->_header = mmap(NULL, mapped->_page, PROT_READ | PROT_WRITE, MAP_SHARED, mapped->_fd, 0);
+    if (mapped->_header == MAP_FAILED)
+    {
+        mapped->_header = NULL;
+        goto fail;
+    }
+
+    if (!st.st_size)
+    {
+        memcpy(((_vec_mapped_header *)mapped->_header)->magic, VEC_MAPPED_MAGIC, sizeof(((_vec_mapped_header *)mapped->_header)->magic));
+        ((_vec_mapped_header *)mapped->_header)->size_width = sizeof(vec_size_t);
+        ((_vec_mapped_header *)mapped->_header)->pow2_capacity = VEC_POW2_CAPACITY;
+        ((_vec_mapped_header *)mapped->_header)->t_size = t_size;
+        ((_vec_mapped_header *)mapped->_header)->data_offset = mapped->_page;
+    }
+    else if (st.st_size < (off_t)mapped->_page)
+    {
+        errno = EINVAL;
+        goto fail;
+    }
+    else if (!_vec_mapped_load(vec_ptr, mapped, st.st_size))
+    {
+        goto fail;
+    }
+
+    return TRUE;
+
+fail:
+    err = errno;
+
+    if (mapped->_header)
+    {
+        munmap(mapped->_header, mapped->_page);
+    }
+
+    close(mapped->_fd);
+    memset(mapped, 0, sizeof(*mapped));
+    memset(vec_ptr, 0, sizeof(*vec_ptr));
+    errno = err;
+
+    return FALSE;
+}
+
+int _impl_vec_sync_mapped(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_mapped *mapped)
+{
+    _vec_mapped_header *header;
+    struct _vec_mapped_region *region;
+
+    if (!vec_ptr || !mapped || !mapped->_header || (vec_ptr->_alloc != &mapped->allocator))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    header = (_vec_mapped_header *)mapped->_header;
+    region = (vec_ptr->_mem ? _vec_mapped_find(mapped, vec_ptr->_mem) : NULL);
+
+    /* Flush the elements before the header that describes them */
+    if (region && msync(region->mem, region->size, MS_SYNC))
+    {
+        return FALSE;
+    }
+
+    header->start = vec_ptr->start;
+    header->size = vec_ptr->size;
+    header->capacity = vec_ptr->capacity;
+    header->data_offset = (region ? region->offset : mapped->_page);
+
+    return !msync(mapped->_header, mapped->_page, MS_SYNC);
+}
+
+int _impl_vec_close_mapped(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_mapped *mapped)
+{
+    int synced = _impl_vec_sync_mapped(vec_ptr, mapped);
+    int err = errno;
+    unsigned int i;
+
+    if (!vec_ptr || !mapped || !mapped->_header)
+    {
+        return FALSE;
+    }
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (mapped->_regions[i].mem)
+        {
+            munmap(mapped->_regions[i].mem, mapped->_regions[i].size);
+        }
+    }
+
+    munmap(mapped->_header, mapped->_page);
+    close(mapped->_fd);
+    memset(mapped, 0, sizeof(*mapped));
+    memset(vec_ptr, 0, sizeof(*vec_ptr));
+    errno = err;
+
+    return synced;
+}
+
+static unsigned long _vec_adler32(unsigned long adler, const unsigned char *buf, size_t len)
+{
+    unsigned long a = adler & 0xffff, b = (adler >> 16) & 0xffff;
+    size_t run;
+
+    while (len)
+    {
+        run = (len < VEC_ADLER_NMAX ? len : VEC_ADLER_NMAX);
+        len -= run;
+
+        while (run--)
+        {
+            a += *buf++;
+            b += a;
+        }
+
+        a %= VEC_ADLER_BASE;
+        b %= VEC_ADLER_BASE;
+    }
+
+    return (b << 16) | a;
+}
+
+static unsigned char _vec_byte_order(void)
+{
+    union
+    {
+        unsigned int  word;
+        unsigned char bytes[sizeof(unsigned int)];
+    } probe;
+
+    probe.word = 1;
+    return (probe.bytes[0] ? VEC_SNAPSHOT_LITTLE : VEC_SNAPSHOT_BIG);
+}
+
+static void _vec_put_le(unsigned char *buf, vec_size_t val, unsigned int len)
+{
+    unsigned int i;
+
+    for (i = 0; i < len; ++i, val >>= 8)
+    {
+        buf[i] = (unsigned char)(val & 0xff);
+    }
+}
+
+/* Returns FALSE if the value doesn't fit in a vec_size_t */
+static int _vec_get_le(const unsigned char *buf, unsigned int len, vec_size_t *val)
+{
+    unsigned int i = len;
+
+    *val = 0;
+
+    while (i--)
+    {
+        if (*val >> (sizeof(vec_size_t) * 8 - 8))
+        {
+            return FALSE;
+        }
+
+        *val = (vec_size_t)((*val << 8) | buf[i]);
+    }
+
+    return TRUE;
+}
+
+/* Transfers all of the bytes described by the I/O vectors, retrying after partial transfers */
+static int _vec_transfer_full(int fd, struct iovec *iov, int count, int write_op)
+{
+    ssize_t done;
+
+    while (count)
+    {
+        done = (write_op ? writev(fd, iov, count) : readv(fd, iov, count));
+
+        if (done < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return FALSE;
+        }
+
+        if (!done)
+        {
+            errno = EBADMSG;
+            return FALSE;
+        }
+
+        while (count && (size_t)done >= iov->iov_len)
+        {
+            done -= (ssize_t)iov->iov_len;
+            ++iov;
+            --count;
+        }
+
+        if (count)
+        {
+            iov->iov_base = (unsigned char *)iov->iov_base + done;
+            iov->iov_len -= (size_t)done;
+        }
+    }
+
+    return TRUE;
+}
+
+int _impl_vec_save(const _IMPL_VEC_STRUCT_NAME *vec_ptr, int fd)
+{
+    unsigned char header[VEC_SNAPSHOT_HEADER];
+    _IMPL_VEC_SPAN_NAME spans[2];
+    struct iovec iov[3];
+    unsigned long checksum = 1;
+    int count = 1, i;
+
+    if (!vec_ptr || !_impl_vec_slice(vec_ptr, 0, vec_ptr->size, spans))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, VEC_SNAPSHOT_MAGIC, 8);
+    _vec_put_le(&header[8], VEC_SNAPSHOT_VERSION, 2);
+    header[10] = _vec_byte_order();
+    _vec_put_le(&header[12], vec_ptr->_t_size, 4);
+    _vec_put_le(&header[16], vec_ptr->size, 8);
+
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (spans[i].size)
+        {
+            iov[count].iov_base = spans[i].data;
+            iov[count].iov_len = (size_t)spans[i].size * vec_ptr->_t_size;
+            checksum = _vec_adler32(checksum, (const unsigned char *)spans[i].data, iov[count].iov_len);
+            ++count;
+        }
+    }
+
+    _vec_put_le(&header[24], (vec_size_t)checksum, 4);
+
+    return _vec_transfer_full(fd, iov, count, TRUE);
+}
+
+int _impl_vec_load_begin(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd, vec_load_state *state)
+{
+    unsigned char header[VEC_SNAPSHOT_HEADER];
+    struct iovec iov;
+    vec_size_t version, t_size, count, checksum;
+
+    if (!vec_ptr || !vec_ptr->_t_size || !state)
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    iov.iov_base = header;
+    iov.iov_len = sizeof(header);
+
+    if (!_vec_transfer_full(fd, &iov, 1, FALSE))
+    {
+        return FALSE;
+    }
+
+    _vec_get_le(&header[8], 2, &version);
+    _vec_get_le(&header[12], 4, &t_size);
+    _vec_get_le(&header[24], 4, &checksum);
+
+    if (memcmp(header, VEC_SNAPSHOT_MAGIC, 8))
+    {
+        errno = EBADMSG;
+        return FALSE;
+    }
+
+    if (version != VEC_SNAPSHOT_VERSION)
+    {
+        errno = ENOTSUP;
+        return FALSE;
+    }
+
+    /* The elements are opaque, so they can only be loaded in the byte order they were saved in */
+    if ((header[10] != _vec_byte_order()) || (t_size != vec_ptr->_t_size))
+    {
+        errno = EINVAL;
+        return FALSE;
+    }
+
+    if (!_vec_get_le(&header[16], 8, &count) || (vec_ptr->size + count < count))
+    {
+        errno = EOVERFLOW;
+        return FALSE;
+    }
+
+    if (!_impl_vec_reserve(vec_ptr, vec_ptr->size + count))
+    {
+        errno = ENOMEM;
+        return FALSE;
+    }
+
+    state->remaining = count;
+    state->_fd = fd;
+    state->_checksum = 1;
+    state->_expected = (unsigned long)checksum;
+
+    return TRUE;
+}
+
+ssize_t _impl_vec_load_chunk(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_load_state *state, vec_size_t len)
+{
+    _IMPL_VEC_SPAN_NAME spans[2];
+    struct iovec iov[2];
+    int i;
+
+    if (!vec_ptr || !state || !len)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (!state->remaining)
+    {
+        if (state->_checksum != state->_expected)
+        {
+            errno = EBADMSG;
+            return -1;
+        }
+
+        return 0;
+    }
+
+    len = (len < state->remaining ? len : state->remaining);
+
+    /* The room was reserved by _impl_vec_load_begin, so the elements are read in place */
+    if (!_impl_vec_extend(vec_ptr, len, spans))
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (i = 0; i < 2; ++i)
+    {
+        iov[i].iov_base = spans[i].data;
+        iov[i].iov_len = (size_t)spans[i].size * vec_ptr->_t_size;
+    }
+
+    if (!_vec_transfer_full(state->_fd, iov, spans[1].size ? 2 : 1, FALSE))
+    {
+        vec_ptr->size -= len;
+        return -1;
+    }
+
+    for (i = 0; i < 2; ++i)
+    {
+        state->_checksum = _vec_adler32(state->_checksum, (const unsigned char *)spans[i].data,
+                                        (size_t)spans[i].size * vec_ptr->_t_size);
+    }
+
+    state->remaining -= len;
+    return (ssize_t)len;
+}
+
+int _impl_vec_load(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd)
+{
+    vec_load_state state;
+    vec_size_t size;
+    ssize_t count;
+
+    if (!_impl_vec_load_begin(vec_ptr, fd, &state))
+    {
+        return FALSE;
+    }
+
+    size = vec_ptr->size;
+
+    do
+    {
+        count = _impl_vec_load_chunk(vec_ptr, &state, VEC_SNAPSHOT_CHUNK / vec_ptr->_t_size + 1);
+    } while (count > 0);
+
+    /* Drop the elements of a snapshot that turned out to be truncated or corrupt */
+    if (count < 0)
+    {
+        vec_ptr->size = size;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+#ifdef __cplusplus
+} /* extern "C" { */
+#endif /* __cplusplus */
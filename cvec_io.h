@@ -0,0 +1,405 @@
+/**
+ * @file    cvec_io.h
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  File descriptor I/O for byte vectors in ANSI C with POSIX scatter/gather I/O.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#ifndef _GENERIC_CVEC_IO_H_
+#define _GENERIC_CVEC_IO_H_
+
+#include <sys/types.h>
+#include "cvec.h"
+
+/****************************************************************************************
+  Internal Type Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * Defines a range of a file that is mapped to memory by a <code>vec_mapped</code>
+ */
+struct _vec_mapped_region
+{
+    unsigned char *mem;
+    size_t         offset;
+    size_t         size;
+};
+
+/****************************************************************************************
+  External Type Definitions
+ ***************************************************************************************/
+/**
+ * Defines the state of the file that a <code>vec</code> declared with
+ * <code>using_vec_mapped</code> keeps its elements in. Its allocator maps
+ * ranges of the file instead of allocating memory. There are at most two
+ * of them, while a <code>vec</code> copies its elements from one buffer
+ * to another.
+ */
+typedef struct vec_mapped
+{
+    /** The allocator attached to the vec */
+    vec_allocator             allocator;
+    int                       _fd;
+    size_t                    _page;
+    void                     *_header;
+    struct _vec_mapped_region _regions[2];
+} vec_mapped;
+
+/**
+ * Defines the state of a snapshot that is loaded into a <code>vec</code> in chunks
+ */
+typedef struct vec_load_state
+{
+    /** The amount of elements that are left to load */
+    vec_size_t    remaining;
+    int           _fd;
+    unsigned long _checksum;
+    unsigned long _expected;
+} vec_load_state;
+
+/****************************************************************************************
+  Internal Function Declarations
+ ***************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @internal
+ * @brief   Reads data from a file descriptor into the free space of a byte <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] fd        The file descriptor to read from.
+ * @param[in] len       The maximal amount of bytes to read.
+ *
+ * @note      Room for @p len more bytes is made according to the growth policy,
+ *            and the data is read in place with a single <code>readv</code> into
+ *            the free space before and after the buffer end.
+ *
+ * @return    The amount of bytes read, 0 on end of file or -1 on error (with
+ *            <code>errno</code> set).
+ */
+extern ssize_t (_impl_vec_read_fd)(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Writes the contents of a byte <code>vec</code> to a file descriptor
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] fd        The file descriptor to write to.
+ *
+ * @note      The data is written with a single <code>writev</code> of the elements
+ *            before and after the buffer end, and the bytes that were written are
+ *            consumed from the front of the <code>vec</code>.
+ *
+ * @return    The amount of bytes written or -1 on error (with <code>errno</code> set).
+ */
+extern ssize_t (_impl_vec_write_fd)(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd);
+
+/**
+ * @internal
+ * @brief   Opens a file and maps a <code>vec</code> to it
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] t_size    The size of the type in bytes
+ *                      (the result of the <code>sizeof</code> operator).
+ * @param[in] mapped    Pointer to the state of the mapped file.
+ * @param[in] path      The path of the file.
+ * @param[in] flags     A combination of the VEC_MAPPED_* flags.
+ *
+ * @note      A file that isn't empty must have been written by a <code>vec</code> of
+ *            the same element size, in the same capacity mode.
+ *
+ * @return    TRUE if the file was mapped. FALSE otherwise (with <code>errno</code> set).
+ */
+extern int (_impl_vec_open_mapped)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_size_t t_size, vec_mapped *mapped, const char *path, int flags);
+
+/**
+ * @internal
+ * @brief   Writes the state of a mapped <code>vec</code> to its file and flushes
+ *          the file to the storage
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] mapped    Pointer to the state of the mapped file.
+ *
+ * @return    TRUE if the file was flushed. FALSE otherwise (with <code>errno</code> set).
+ */
+extern int (_impl_vec_sync_mapped)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_mapped *mapped);
+
+/**
+ * @internal
+ * @brief   Flushes the file of a mapped <code>vec</code>, unmaps it and closes it
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] mapped    Pointer to the state of the mapped file.
+ *
+ * @return    TRUE if the file was flushed. FALSE otherwise (with <code>errno</code> set).
+ *            The file is closed in either case.
+ */
+extern int (_impl_vec_close_mapped)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_mapped *mapped);
+
+/**
+ * @internal
+ * @brief   Writes a snapshot of the elements of a <code>vec</code> to a file descriptor
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] fd        The file descriptor to write to.
+ *
+ * @note      The header and the elements before and after the buffer end are written
+ *            with <code>writev</code>, straight from the memory of the <code>vec</code>.
+ *
+ * @return    TRUE if the snapshot was written. FALSE otherwise (with <code>errno</code> set).
+ */
+extern int (_impl_vec_save)(const _IMPL_VEC_STRUCT_NAME *vec_ptr, int fd);
+
+/**
+ * @internal
+ * @brief   Reads the header of a snapshot and reserves room for its elements in a <code>vec</code>
+ *
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  fd       The file descriptor to read from.
+ * @param[out] state    The state of the snapshot to pass to <code>_impl_vec_load_chunk</code>.
+ *
+ * @return     TRUE if the header is valid and the room was reserved.
+ *             FALSE otherwise (with <code>errno</code> set).
+ */
+extern int (_impl_vec_load_begin)(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd, vec_load_state *state);
+
+/**
+ * @internal
+ * @brief   Appends the next elements of a snapshot to the end of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] state     The state of the snapshot.
+ * @param[in] len       The maximal amount of elements to load.
+ *
+ * @return    The amount of elements loaded, 0 once all of them were loaded and their checksum
+ *            matched, or -1 on error (with <code>errno</code> set). The elements of a failed
+ *            chunk aren't appended, but the ones of the previous chunks remain.
+ */
+extern ssize_t (_impl_vec_load_chunk)(_IMPL_VEC_STRUCT_NAME *vec_ptr, vec_load_state *state, vec_size_t len);
+
+/**
+ * @internal
+ * @brief   Appends the elements of a snapshot to the end of a <code>vec</code>
+ *
+ * @param[in] vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in] fd        The file descriptor to read from.
+ *
+ * @return    TRUE if the snapshot was loaded. FALSE otherwise (with <code>errno</code> set),
+ *            in which case none of its elements are appended.
+ */
+extern int (_impl_vec_load)(_IMPL_VEC_STRUCT_NAME *vec_ptr, int fd);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/****************************************************************************************
+  External Macro Definitions
+ ***************************************************************************************/
+#define vec_read_fd(type) _VEC_CAT(_vec_read_fd, type)
+#define vec_write_fd(type) _VEC_CAT(_vec_write_fd, type)
+#define vec_open_mapped(type) _VEC_CAT(_vec_open_mapped, type)
+#define vec_sync_mapped(type) _VEC_CAT(_vec_sync_mapped, type)
+#define vec_close_mapped(type) _VEC_CAT(_vec_close_mapped, type)
+#define vec_save(type) _VEC_CAT(_vec_save, type)
+#define vec_load(type) _VEC_CAT(_vec_load, type)
+#define vec_load_begin(type) _VEC_CAT(_vec_load_begin, type)
+#define vec_load_chunk(type) _VEC_CAT(_vec_load_chunk, type)
+
+/** Creates the file if it doesn't exist */
+#define VEC_MAPPED_CREATE   1
+/** Discards the contents of the file */
+#define VEC_MAPPED_TRUNCATE 2
+
+/**
+ * Gets the type name of a <code>vec</code> of type <code>type</code> that is mapped to a file
+ *
+ * @param[in] type  The type that is stored in the <code>vec</code>.
+ */
+#define vec_mapped_type(type) _VEC_CAT(_vec_mapped, type)
+
+/**
+ * Defines the file descriptor I/O functions of a byte sized <code>vec</code> of type
+ * <code>type</code> (which must have been declared with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_io(type) \
+    /**
+     * @brief   Reads data from a file descriptor to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] fd        The file descriptor to read from.
+     * @param[in] len       The maximal amount of elements to read.
+     *
+     * @return    The amount of elements read, 0 on end of file or -1 on error.
+     */ \
+    static ssize_t _VEC_CAT(_vec_read_fd, type)(vec_type(type) *vec_ptr, int fd, vec_size_t len) { \
+        return (_impl_vec_read_fd)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, fd, len); \
+    } \
+    /**
+     * @brief   Writes the elements of a <code>vec</code> to a file descriptor
+     *          and removes the ones that were written from its beginning
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] fd        The file descriptor to write to.
+     *
+     * @return    The amount of elements written or -1 on error.
+     */ \
+    static ssize_t _VEC_CAT(_vec_write_fd, type)(vec_type(type) *vec_ptr, int fd) { \
+        return (_impl_vec_write_fd)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, fd); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_io declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_io, vec_cmp_type(type))
+
+/**
+ * Defines a <code>vec</code> of type <code>type</code> whose elements are kept in a
+ * memory mapped file (<code>type</code> must have been declared with
+ * <code>using_vec_type</code> beforehand). The vector itself is the <code>vec</code>
+ * member of the structure, which is used with the regular <code>vec</code> functions.
+ */
+#define using_vec_mapped(type) \
+    typedef struct _VEC_CAT(_vectag, vec_mapped_type(type)) \
+    { \
+        vec_type(type) vec; \
+        vec_mapped     _mapped; \
+    } vec_mapped_type(type); \
+    \
+    /**
+     * @brief   Opens a file and maps a <code>vec</code> to it
+     *
+     * @param[in] mapped_ptr    Pointer to a structure that holds a <code>vec</code> and its file.
+     * @param[in] path          The path of the file.
+     * @param[in] flags         A combination of the VEC_MAPPED_* flags.
+     *
+     * @return    TRUE if the file was mapped. FALSE otherwise.
+     *
+     * @note      The structure points into itself, so it must not be copied or moved
+     *            while the file is open.
+     */ \
+    static int _VEC_CAT(_vec_open_mapped, type)(vec_mapped_type(type) *mapped_ptr, const char *path, int flags) { \
+        if (!mapped_ptr) { \
+            return FALSE; \
+        } \
+        return (_impl_vec_open_mapped)((_IMPL_VEC_STRUCT_NAME *)&mapped_ptr->vec, sizeof(type), &mapped_ptr->_mapped, path, flags); \
+    } \
+    /**
+     * @brief   Writes the size of a mapped <code>vec</code> to its file and flushes the file
+     *
+     * @param[in] mapped_ptr    Pointer to a structure that holds a <code>vec</code> and its file.
+     *
+     * @return    TRUE if the file was flushed. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_sync_mapped, type)(vec_mapped_type(type) *mapped_ptr) { \
+        if (!mapped_ptr) { \
+            return FALSE; \
+        } \
+        return (_impl_vec_sync_mapped)((_IMPL_VEC_STRUCT_NAME *)&mapped_ptr->vec, &mapped_ptr->_mapped); \
+    } \
+    /**
+     * @brief   Flushes and closes the file of a mapped <code>vec</code>
+     *
+     * @param[in] mapped_ptr    Pointer to a structure that holds a <code>vec</code> and its file.
+     *
+     * @return    TRUE if the file was flushed. FALSE otherwise.
+     *
+     * @note      This function must be called instead of <code>vec_clear</code>,
+     *            which would discard the elements.
+     */ \
+    static int _VEC_CAT(_vec_close_mapped, type)(vec_mapped_type(type) *mapped_ptr) { \
+        if (!mapped_ptr) { \
+            return FALSE; \
+        } \
+        return (_impl_vec_close_mapped)((_IMPL_VEC_STRUCT_NAME *)&mapped_ptr->vec, &mapped_ptr->_mapped); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_mapped declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_mapped, vec_cmp_type(type))
+
+/**
+ * Defines the snapshot functions of a <code>vec</code> of type <code>type</code>
+ * (which must have been declared with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_snapshot(type) \
+    /**
+     * @brief   Writes a snapshot of the elements of a <code>vec</code> to a file descriptor
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] fd        The file descriptor to write to.
+     *
+     * @return    TRUE if the snapshot was written. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_save, type)(const vec_type(type) *vec_ptr, int fd) { \
+        return (_impl_vec_save)((const _IMPL_VEC_STRUCT_NAME *)vec_ptr, fd); \
+    } \
+    /**
+     * @brief   Appends the elements of a snapshot to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] fd        The file descriptor to read from.
+     *
+     * @return    TRUE if the snapshot was loaded. FALSE otherwise, in which case
+     *            none of its elements are appended.
+     */ \
+    static int _VEC_CAT(_vec_load, type)(vec_type(type) *vec_ptr, int fd) { \
+        return (_impl_vec_load)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, fd); \
+    } \
+    /**
+     * @brief   Reads the header of a snapshot and reserves room for its elements in a <code>vec</code>
+     *
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  fd       The file descriptor to read from.
+     * @param[out] state    The state of the snapshot to pass to <code>vec_load_chunk</code>.
+     *
+     * @return     TRUE if the header is valid and the room was reserved. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_load_begin, type)(vec_type(type) *vec_ptr, int fd, vec_load_state *state) { \
+        return (_impl_vec_load_begin)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, fd, state); \
+    } \
+    /**
+     * @brief   Appends the next elements of a snapshot to the end of a <code>vec</code>
+     *
+     * @param[in] vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in] state     The state of the snapshot.
+     * @param[in] len       The maximal amount of elements to load.
+     *
+     * @return    The amount of elements loaded, 0 once all of them were loaded and
+     *            their checksum matched, or -1 on error.
+     */ \
+    static ssize_t _VEC_CAT(_vec_load_chunk, type)(vec_type(type) *vec_ptr, vec_load_state *state, vec_size_t len) { \
+        return (_impl_vec_load_chunk)((_IMPL_VEC_STRUCT_NAME *)vec_ptr, state, len); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_snapshot declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_snapshot, vec_cmp_type(type))
+
+#endif /* !_GENERIC_CVEC_IO_H_ */
@@ -0,0 +1,685 @@
+/**
+ * @file    cvec_thread.c
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  Multi-threaded algorithms over vectors in ANSI C with POSIX threads.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "cvec_thread.h"
+
+/* The maximal amount of threads an operation is split between */
+#define VEC_MAX_THREADS             64
+
+/* Below this amount of elements a parallel sort isn't worth the thread overhead */
+#define VEC_PARALLEL_SORT_THRESHOLD 32768
+
+/* The amount of bytes in the chunks the parallel algorithms split vecs into. Each chunk
+ * is big enough to amortize handing it to a thread, and small enough to balance the load */
+#define VEC_PARALLEL_CHUNK_SIZE     65536
+
+#define VEC_ELEM(base, idx, t_size) ((base) + (size_t)(idx) * (t_size))
+
+_impl_vec_def_struct(unsigned char, _IMPL_VEC_STRUCT_NAME);
+
+/* A part of a parallel sort. Either sorts the range [lo, hi) of dst in place, or merges the
+ * runs [lo, mid) and [mid, hi) of src and writes the part [lo + first, lo + last) of the
+ * merged range to dst */
+typedef struct _vec_sort_task
+{
+    const unsigned char *src;
+    unsigned char       *dst;
+    size_t               t_size;
+    _IMPL_VEC_CMPFN_NAME cmpfn;
+    vec_size_t           lo;
+    vec_size_t           mid;
+    vec_size_t           hi;
+    vec_size_t           first;
+    vec_size_t           last;
+} _vec_sort_task;
+
+/* A round of the tasks of a parallel sort, run as a batch of a thread pool */
+typedef struct _vec_sort_job
+{
+    void          *(*fn)(void *);
+    _vec_sort_task *tasks;
+} _vec_sort_job;
+
+/* The state of a thread pool. Batches of tasks are handed out one task at a time to
+ * the worker threads and to the thread that runs the batch */
+struct _vec_thread_pool_impl
+{
+    pthread_mutex_t lock;
+    pthread_mutex_t run_lock;
+    pthread_cond_t  work;
+    pthread_cond_t  done;
+    void          (*fn)(void *job, vec_size_t task);
+    void           *job;
+    vec_size_t      next;
+    vec_size_t      count;
+    vec_size_t      pending;
+    int             stop;
+    unsigned int    workers;
+    pthread_t       ids[VEC_MAX_THREADS];
+};
+
+/* A parallel algorithm over the elements of one or two vecs of the same size. The elements
+ * are split into regions that are contiguous in both vecs, and each region is split into
+ * chunks of up to chunk elements. Every chunk is a task */
+typedef struct _vec_parallel_job
+{
+    _IMPL_VEC_SPAN_NAME  src[2];
+    _IMPL_VEC_SPAN_NAME  dst[2];
+    size_t               src_t_size;
+    size_t               dst_t_size;
+    vec_size_t           bounds[4];
+    vec_size_t           tasks[4];
+    unsigned int         regions;
+    vec_size_t           chunk;
+    _impl_vec_for_fn     for_fn;
+    _impl_vec_map_fn     map_fn;
+    _impl_vec_reduce_fn  reduce_fn;
+    void                *ctx;
+    unsigned char       *partials;
+    size_t               acc_size;
+} _vec_parallel_job;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+static void* _vec_pool_worker(void *arg)
+{
+    struct _vec_thread_pool_impl *impl = (struct _vec_thread_pool_impl *)arg;
+
+    pthread_mutex_lock(&impl->lock);
+
+    for (;;)
+    {
+        vec_size_t task = 0;
+
+        while (!impl->stop && impl->next >= impl->count)
+        {
+            pthread_cond_wait(&impl->work, &impl->lock);
+        }
+
+        if (impl->stop)
+        {
+            break;
+        }
+
+        task = impl->next++;
+        pthread_mutex_unlock(&impl->lock);
+        impl->fn(impl->job, task);
+        pthread_mutex_lock(&impl->lock);
+
+        if (!--impl->pending)
+        {
+            pthread_cond_signal(&impl->done);
+        }
+    }
+
+    pthread_mutex_unlock(&impl->lock);
+    return NULL;
+}
+
+static void _vec_pool_run(vec_thread_pool *pool, void (*fn)(void *job, vec_size_t task), void *job, vec_size_t count)
+{
+    struct _vec_thread_pool_impl *impl = (pool ? pool->_impl : NULL);
+    vec_size_t task = 0;
+
+    /* Run the tasks on the calling thread if there's no one to share them with */
+    if (!impl || !impl->workers || count < 2)
+    {
+        for (task = 0; task < count; ++task)
+        {
+            fn(job, task);
+        }
+
+        return;
+    }
+
+    /* Only one batch runs at a time, and the calling thread takes tasks as well */
+    pthread_mutex_lock(&impl->run_lock);
+    pthread_mutex_lock(&impl->lock);
+
+    impl->fn = fn;
+    impl->job = job;
+    impl->next = 0;
+    impl->count = count;
+    impl->pending = count;
+    pthread_cond_broadcast(&impl->work);
+
+    while (impl->next < impl->count)
+    {
+        task = impl->next++;
+        pthread_mutex_unlock(&impl->lock);
+        fn(job, task);
+        pthread_mutex_lock(&impl->lock);
+        --impl->pending;
+    }
+
+    while (impl->pending)
+    {
+        pthread_cond_wait(&impl->done, &impl->lock);
+    }
+
+    impl->count = 0;
+    impl->next = 0;
+
+    pthread_mutex_unlock(&impl->lock);
+    pthread_mutex_unlock(&impl->run_lock);
+}
+
+static int _vec_job_init(_vec_parallel_job *job, const _IMPL_VEC_STRUCT_NAME *src_ptr, const _IMPL_VEC_STRUCT_NAME *dst_ptr, void *ctx)
+{
+    vec_size_t size = 0, cuts[2], region = 0;
+    size_t t_size = 0;
+    unsigned int i = 0;
+
+    memset(job, 0, sizeof(*job));
+
+    if (!src_ptr || !_impl_vec_slice(src_ptr, 0, src_ptr->size, job->src))
+    {
+        return FALSE;
+    }
+
+    size = src_ptr->size;
+    job->src_t_size = src_ptr->_t_size;
+    job->ctx = ctx;
+
+    if (dst_ptr && ((dst_ptr->size != size) || !_impl_vec_slice(dst_ptr, 0, size, job->dst)))
+    {
+        return FALSE;
+    }
+
+    /* Cut the elements where either of the vecs circulates beyond its buffer end */
+    cuts[0] = job->src[0].size;
+    cuts[1] = (dst_ptr ? job->dst[0].size : size);
+    t_size = job->src_t_size;
+
+    if (dst_ptr)
+    {
+        job->dst_t_size = dst_ptr->_t_size;
+        t_size = (job->dst_t_size > t_size ? job->dst_t_size : t_size);
+    }
+
+    if (cuts[0] > cuts[1])
+    {
+        region = cuts[0], cuts[0] = cuts[1], cuts[1] = region;
+    }
+
+    job->chunk = (VEC_PARALLEL_CHUNK_SIZE / t_size ? (vec_size_t)(VEC_PARALLEL_CHUNK_SIZE / t_size) : 1);
+
+    for (i = 0; i < 2; ++i)
+    {
+        if (cuts[i] > job->bounds[job->regions] && cuts[i] < size)
+        {
+            job->bounds[++job->regions] = cuts[i];
+        }
+    }
+
+    if (size)
+    {
+        job->bounds[++job->regions] = size;
+    }
+
+    /* Count the tasks up to the end of every region */
+    for (i = 0; i < job->regions; ++i)
+    {
+        region = job->bounds[i + 1] - job->bounds[i];
+        job->tasks[i + 1] = job->tasks[i] + region / job->chunk + (region % job->chunk != 0);
+    }
+
+    return TRUE;
+}
+
+static void _vec_job_chunk(const _vec_parallel_job *job, vec_size_t task, vec_size_t *idx, vec_size_t *len)
+{
+    unsigned int i = 0;
+
+    for (; task >= job->tasks[i + 1]; ++i);
+
+    *idx = job->bounds[i] + (task - job->tasks[i]) * job->chunk;
+    *len = (job->bounds[i + 1] - *idx < job->chunk ? job->bounds[i + 1] - *idx : job->chunk);
+}
+
+static void* _vec_job_elem(const _IMPL_VEC_SPAN_NAME spans[2], size_t t_size, vec_size_t idx)
+{
+    if (idx < spans[0].size)
+    {
+        return (unsigned char *)spans[0].data + (size_t)idx * t_size;
+    }
+
+    return (unsigned char *)spans[1].data + (size_t)(idx - spans[0].size) * t_size;
+}
+
+static void _vec_for_task(void *arg, vec_size_t task)
+{
+    _vec_parallel_job *job = (_vec_parallel_job *)arg;
+    vec_size_t idx = 0, len = 0;
+
+    _vec_job_chunk(job, task, &idx, &len);
+    job->for_fn(_vec_job_elem(job->src, job->src_t_size, idx), idx, len, job->ctx);
+}
+
+static void _vec_map_task(void *arg, vec_size_t task)
+{
+    _vec_parallel_job *job = (_vec_parallel_job *)arg;
+    vec_size_t idx = 0, len = 0;
+
+    _vec_job_chunk(job, task, &idx, &len);
+    job->map_fn(_vec_job_elem(job->src, job->src_t_size, idx),
+                _vec_job_elem(job->dst, job->dst_t_size, idx), len, job->ctx);
+}
+
+static void _vec_reduce_task(void *arg, vec_size_t task)
+{
+    _vec_parallel_job *job = (_vec_parallel_job *)arg;
+    vec_size_t idx = 0, len = 0;
+
+    _vec_job_chunk(job, task, &idx, &len);
+    job->reduce_fn(job->partials + (size_t)task * job->acc_size, _vec_job_elem(job->src, job->src_t_size, idx), len, job->ctx);
+}
+
+static vec_size_t _vec_split(vec_size_t len, unsigned int part, unsigned int parts)
+{
+    /* Avoid integer overflow by splitting the whole parts from the remainder */
+    return len / parts * part + len % parts * part / parts;
+}
+
+static void _vec_sort_pool_task(void *arg, vec_size_t task)
+{
+    _vec_sort_job *job = (_vec_sort_job *)arg;
+
+    job->fn(&job->tasks[task]);
+}
+
+static void _vec_run_tasks(vec_thread_pool *pool, void *(*fn)(void *), _vec_sort_task *tasks, unsigned int count)
+{
+    pthread_t ids[VEC_MAX_THREADS + 1];
+    int started[VEC_MAX_THREADS + 1];
+    _vec_sort_job job;
+    unsigned int i = 0;
+
+    /* Hand the tasks to the threads of a pool that runs them all */
+    if (pool)
+    {
+        job.fn = fn;
+        job.tasks = tasks;
+        _vec_pool_run(pool, _vec_sort_pool_task, &job, count);
+        return;
+    }
+
+    /* Otherwise run the first task on the calling thread, as well as any task that a
+     * thread couldn't be created for */
+    for (i = 1; i < count; ++i)
+    {
+        started[i] = !pthread_create(&ids[i], NULL, fn, &tasks[i]);
+        if (!started[i])
+        {
+            fn(&tasks[i]);
+        }
+    }
+
+    fn(&tasks[0]);
+
+    for (i = 1; i < count; ++i)
+    {
+        if (started[i])
+        {
+            pthread_join(ids[i], NULL);
+        }
+    }
+}
+
+static void* _vec_sort_chunk(void *arg)
+{
+    _vec_sort_task *task = (_vec_sort_task *)arg;
+
+    qsort(VEC_ELEM(task->dst, task->lo, task->t_size), task->hi - task->lo, task->t_size, task->cmpfn);
+    return NULL;
+}
+
+static vec_size_t _vec_co_rank(const _vec_sort_task *task, vec_size_t count)
+{
+    const unsigned char *src = task->src;
+    size_t t_size = task->t_size;
+    vec_size_t left = task->mid - task->lo, right = task->hi - task->mid;
+    vec_size_t lo = (count > right ? count - right : 0), hi = (count < left ? count : left);
+
+    /* Find how many of the first count merged elements come from the left run. Ties are
+     * resolved in favor of the left run, the same as in a serial merge */
+    while (lo < hi)
+    {
+        vec_size_t i = lo + ((hi - lo) >> 1);
+
+        if (task->cmpfn(VEC_ELEM(src, task->mid + count - i - 1, t_size), VEC_ELEM(src, task->lo + i, t_size)) >= 0)
+        {
+            lo = i + 1;
+        }
+        else
+        {
+            hi = i;
+        }
+    }
+
+    return lo;
+}
+
+static void* _vec_merge_part(void *arg)
+{
+    _vec_sort_task *task = (_vec_sort_task *)arg;
+    size_t t_size = task->t_size;
+    vec_size_t left = task->lo + _vec_co_rank(task, task->first);
+    vec_size_t right = task->mid + task->first - (left - task->lo);
+    vec_size_t out = task->lo + task->first, end = task->lo + task->last;
+
+    for (; out < end; ++out)
+    {
+        if (right < task->hi &&
+            (left >= task->mid || task->cmpfn(VEC_ELEM(task->src, right, t_size), VEC_ELEM(task->src, left, t_size)) < 0))
+        {
+            memcpy(VEC_ELEM(task->dst, out, t_size), VEC_ELEM(task->src, right++, t_size), t_size);
+        }
+        else
+        {
+            memcpy(VEC_ELEM(task->dst, out, t_size), VEC_ELEM(task->src, left++, t_size), t_size);
+        }
+    }
+
+    return NULL;
+}
+
+int _impl_vec_sort_parallel(vec_thread_pool *pool, _IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned int threads)
+{
+    _vec_sort_task tasks[VEC_MAX_THREADS + 1];
+    vec_size_t bounds[VEC_MAX_THREADS + 1];
+    unsigned char *src = NULL, *dst = NULL, *buf = NULL;
+    unsigned int chunks = 0, count = 0, parts = 0, i = 0, j = 0;
+    vec_size_t size = 0;
+    size_t bytes = 0;
+
+    if (threads > VEC_MAX_THREADS)
+    {
+        threads = VEC_MAX_THREADS;
+    }
+
+    /* Sort small vectors serially */
+    if (!vec_ptr || !cmpfn || (threads < 2) || (vec_ptr->size < VEC_PARALLEL_SORT_THRESHOLD))
+    {
+        return _impl_vec_sort(vec_ptr, cmpfn);
+    }
+
+    /* Align the elements so they can be split into chunks */
+    if (!(src = (unsigned char *)_impl_vec_data(vec_ptr)))
+    {
+        return FALSE;
+    }
+
+    /* Sort serially if there's no memory to merge into */
+    size = vec_ptr->size;
+    bytes = (size_t)size * vec_ptr->_t_size;
+    if (!(buf = (unsigned char *)_impl_vec_scratch_alloc(vec_ptr, bytes)))
+    {
+        return _impl_vec_sort(vec_ptr, cmpfn);
+    }
+
+    dst = buf;
+
+    /* Sort a chunk of the elements on every thread */
+    for (chunks = threads, i = 0; i <= chunks; ++i)
+    {
+        bounds[i] = _vec_split(size, i, chunks);
+    }
+
+    for (i = 0; i < chunks; ++i)
+    {
+        tasks[i].src = src;
+        tasks[i].dst = src;
+        tasks[i].t_size = vec_ptr->_t_size;
+        tasks[i].cmpfn = cmpfn;
+        tasks[i].lo = bounds[i];
+        tasks[i].mid = bounds[i + 1];
+        tasks[i].hi = bounds[i + 1];
+        tasks[i].first = 0;
+        tasks[i].last = bounds[i + 1] - bounds[i];
+    }
+
+    _vec_run_tasks(pool, _vec_sort_chunk, tasks, chunks);
+
+    /* Merge pairs of adjacent chunks back and forth between the vec and the buffer until a
+     * single chunk is left. Every pair is split between an equal share of the threads, and
+     * an odd chunk out is merged with nothing, which just copies it */
+    while (chunks > 1)
+    {
+        parts = threads / (chunks >> 1);
+
+        for (count = 0, i = 0; i < chunks; i += 2)
+        {
+            vec_size_t lo = bounds[i], mid = bounds[i + 1], hi = (i + 1 < chunks ? bounds[i + 2] : mid);
+
+            for (j = 0; j < (i + 1 < chunks ? parts : 1); ++j, ++count)
+            {
+                tasks[count].src = src;
+                tasks[count].dst = dst;
+                tasks[count].t_size = vec_ptr->_t_size;
+                tasks[count].cmpfn = cmpfn;
+                tasks[count].lo = lo;
+                tasks[count].mid = mid;
+                tasks[count].hi = hi;
+                tasks[count].first = _vec_split(hi - lo, j, (i + 1 < chunks ? parts : 1));
+                tasks[count].last = _vec_split(hi - lo, j + 1, (i + 1 < chunks ? parts : 1));
+            }
+
+            bounds[i >> 1] = lo;
+        }
+
+        chunks = (chunks + 1) >> 1;
+        bounds[chunks] = size;
+
+        _vec_run_tasks(pool, _vec_merge_part, tasks, count);
+
+        dst = src;
+        src = tasks[0].dst;
+    }
+
+    if (src == buf)
+    {
+        memcpy(dst, buf, bytes);
+    }
+
+    _impl_vec_scratch_free(vec_ptr, buf, bytes);
+
+    return TRUE;
+}
+
+int _impl_vec_parallel_for(vec_thread_pool *pool, _IMPL_VEC_STRUCT_NAME *vec_ptr, _impl_vec_for_fn fn, void *ctx)
+{
+    _vec_parallel_job job;
+
+    if (!fn || !_vec_job_init(&job, vec_ptr, NULL, ctx))
+    {
+        return FALSE;
+    }
+
+    job.for_fn = fn;
+    _vec_pool_run(pool, _vec_for_task, &job, job.tasks[job.regions]);
+    return TRUE;
+}
+
+int _impl_vec_parallel_map(vec_thread_pool *pool, const _IMPL_VEC_STRUCT_NAME *src_ptr, _IMPL_VEC_STRUCT_NAME *dst_ptr, _impl_vec_map_fn fn, void *ctx)
+{
+    _vec_parallel_job job;
+
+    if (!fn || !dst_ptr || (dst_ptr == src_ptr) || !_vec_job_init(&job, src_ptr, dst_ptr, ctx))
+    {
+        return FALSE;
+    }
+
+    job.map_fn = fn;
+    _vec_pool_run(pool, _vec_map_task, &job, job.tasks[job.regions]);
+    return TRUE;
+}
+
+int _impl_vec_parallel_reduce(vec_thread_pool *pool, const _IMPL_VEC_STRUCT_NAME *vec_ptr, void *acc, size_t acc_size,
+                              _impl_vec_reduce_fn reduce, _impl_vec_combine_fn combine, void *ctx)
+{
+    _vec_parallel_job job;
+    vec_size_t task = 0, count = 0;
+
+    if (!acc || !acc_size || !reduce || !combine || !_vec_job_init(&job, vec_ptr, NULL, ctx))
+    {
+        return FALSE;
+    }
+
+    /* Every chunk is reduced into its own copy of the identity value */
+    count = job.tasks[job.regions];
+    if (count && !(job.partials = (unsigned char *)malloc((size_t)count * acc_size)))
+    {
+        return FALSE;
+    }
+
+    job.reduce_fn = reduce;
+    job.acc_size = acc_size;
+
+    for (task = 0; task < count; ++task)
+    {
+        memcpy(job.partials + (size_t)task * acc_size, acc, acc_size);
+    }
+
+    _vec_pool_run(pool, _vec_reduce_task, &job, count);
+
+    /* Combine the partial results in order, so the reduction doesn't have to be commutative */
+    for (task = 0; task < count; ++task)
+    {
+        combine(acc, job.partials + (size_t)task * acc_size, ctx);
+    }
+
+    free(job.partials);
+    return TRUE;
+}
+
+int vec_thread_pool_init(vec_thread_pool *pool, unsigned int threads)
+{
+    struct _vec_thread_pool_impl *impl = NULL;
+
+    if (!pool)
+    {
+        return FALSE;
+    }
+
+    pool->_impl = NULL;
+
+    if (!(impl = (struct _vec_thread_pool_impl *)malloc(sizeof(*impl))))
+    {
+        return FALSE;
+    }
+
+    memset(impl, 0, sizeof(*impl));
+
+    if (pthread_mutex_init(&impl->lock, NULL))
+    {
+        free(impl);
+        return FALSE;
+    }
+
+    if (pthread_mutex_init(&impl->run_lock, NULL))
+    {
+        pthread_mutex_destroy(&impl->lock);
+        free(impl);
+        return FALSE;
+    }
+
+    if (pthread_cond_init(&impl->work, NULL))
+    {
+        pthread_mutex_destroy(&impl->run_lock);
+        pthread_mutex_destroy(&impl->lock);
+        free(impl);
+        return FALSE;
+    }
+
+    if (pthread_cond_init(&impl->done, NULL))
+    {
+        pthread_cond_destroy(&impl->work);
+        pthread_mutex_destroy(&impl->run_lock);
+        pthread_mutex_destroy(&impl->lock);
+        free(impl);
+        return FALSE;
+    }
+
+    pool->_impl = impl;
+
+    /* The thread that runs a batch takes part in it, so it doesn't need a worker */
+    threads = (threads > VEC_MAX_THREADS ? VEC_MAX_THREADS : threads);
+
+    for (; impl->workers + 1 < threads; ++impl->workers)
+    {
+        if (pthread_create(&impl->ids[impl->workers], NULL, _vec_pool_worker, impl))
+        {
+            vec_thread_pool_release(pool);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+void vec_thread_pool_release(vec_thread_pool *pool)
+{
+    struct _vec_thread_pool_impl *impl = (pool ? pool->_impl : NULL);
+    unsigned int i = 0;
+
+    if (impl)
+    {
+        pthread_mutex_lock(&impl->lock);
+        impl->stop = TRUE;
+        pthread_cond_broadcast(&impl->work);
+        pthread_mutex_unlock(&impl->lock);
+
+        for (i = 0; i < impl->workers; ++i)
+        {
+            pthread_join(impl->ids[i], NULL);
+        }
+
+        pthread_cond_destroy(&impl->done);
+        pthread_cond_destroy(&impl->work);
+        pthread_mutex_destroy(&impl->run_lock);
+        pthread_mutex_destroy(&impl->lock);
+        free(impl);
+        pool->_impl = NULL;
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C" { */
+#endif /* __cplusplus */
@@ -0,0 +1,262 @@
+/**
+ * @file    cvec_thread.h
+ * @author  Isaac Garzon
+ * @since   16/10/2026
+ *
+ * @section DESCRIPTION
+ *
+ *  Multi-threaded algorithms over vectors in ANSI C with POSIX threads.
+ *
+ * @section LICENSE
+ *
+ *  Copyright (c) 2015 Isaac Garzon
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE
+ */
+
+#ifndef _GENERIC_CVEC_THREAD_H_
+#define _GENERIC_CVEC_THREAD_H_
+
+#include "cvec.h"
+
+/****************************************************************************************
+  Internal Type Definitions
+ ***************************************************************************************/
+/**
+ * @internal
+ * Declares the state of a thread pool
+ */
+struct _vec_thread_pool_impl;
+
+/**
+ * @internal
+ * Defines the generic per chunk callbacks of the parallel algorithms.
+ */
+typedef void (*_impl_vec_for_fn)(void *elems, vec_size_t idx, vec_size_t len, void *ctx);
+typedef void (*_impl_vec_map_fn)(const void *src, void *dst, vec_size_t len, void *ctx);
+typedef void (*_impl_vec_reduce_fn)(void *acc, const void *elems, vec_size_t len, void *ctx);
+typedef void (*_impl_vec_combine_fn)(void *acc, const void *partial, void *ctx);
+
+/****************************************************************************************
+  External Type Definitions
+ ***************************************************************************************/
+/**
+ * Defines a pool of threads that the parallel algorithms split their work between.
+ */
+typedef struct vec_thread_pool
+{
+    struct _vec_thread_pool_impl *_impl;
+} vec_thread_pool;
+
+/****************************************************************************************
+  Internal Function Declarations
+ ***************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @internal
+ * @brief   Sorts a <code>vec</code> using multiple threads
+ *
+ * @param[in]  pool     Pointer to a thread pool to run the sort on, or NULL to start
+ *                      threads for it.
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  cmpfn    Pointer to comparer function.
+ * @param[in]  threads  The amount of threads to sort with.
+ *
+ * @note       Each thread sorts a chunk of the elements, and then the chunks are merged in
+ *             rounds in which every thread merges a part of a pair of chunks. Small vectors
+ *             are sorted on the calling thread.
+ *
+ * @return     TRUE if the sort succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_sort_parallel)(vec_thread_pool *pool, _IMPL_VEC_STRUCT_NAME *vec_ptr, _IMPL_VEC_CMPFN_NAME cmpfn, unsigned int threads);
+
+/**
+ * @internal
+ * @brief   Calls a function on the chunks of a <code>vec</code> using a thread pool
+ *
+ * @param[in]  pool     Pointer to a thread pool, or NULL to run on the calling thread.
+ * @param[in]  vec_ptr  Pointer to a generic <code>vec</code> structure.
+ * @param[in]  fn       The function to call with each chunk of contiguous elements,
+ *                      the index of its first element and its length.
+ * @param[in]  ctx      The context to pass to @p fn.
+ *
+ * @return     TRUE if @p fn was called on all the elements. FALSE otherwise.
+ */
+extern int (_impl_vec_parallel_for)(vec_thread_pool *pool, _IMPL_VEC_STRUCT_NAME *vec_ptr, _impl_vec_for_fn fn, void *ctx);
+
+/**
+ * @internal
+ * @brief   Transforms the elements of a <code>vec</code> into another one using a thread pool
+ *
+ * @param[in]  pool     Pointer to a thread pool, or NULL to run on the calling thread.
+ * @param[in]  src_ptr  Pointer to the generic <code>vec</code> structure to transform.
+ * @param[in]  dst_ptr  Pointer to a generic <code>vec</code> structure of the same size
+ *                      to store the transformed elements in.
+ * @param[in]  fn       The function to call with each pair of chunks of contiguous
+ *                      elements at the same indices and their length.
+ * @param[in]  ctx      The context to pass to @p fn.
+ *
+ * @return     TRUE if all the elements were transformed. FALSE otherwise.
+ */
+extern int (_impl_vec_parallel_map)(vec_thread_pool *pool, const _IMPL_VEC_STRUCT_NAME *src_ptr, _IMPL_VEC_STRUCT_NAME *dst_ptr, _impl_vec_map_fn fn, void *ctx);
+
+/**
+ * @internal
+ * @brief   Reduces the elements of a <code>vec</code> to a single value using a thread pool
+ *
+ * @param[in]     pool      Pointer to a thread pool, or NULL to run on the calling thread.
+ * @param[in]     vec_ptr   Pointer to a generic <code>vec</code> structure.
+ * @param[in,out] acc       The identity value of the reduction on input, and its result on output.
+ * @param[in]     acc_size  The size of the value pointed by @p acc.
+ * @param[in]     reduce    The function that accumulates a chunk of contiguous elements into a
+ *                          copy of the identity value.
+ * @param[in]     combine   The function that accumulates the partial results of the chunks
+ *                          into @p acc, in the order of the chunks.
+ * @param[in]     ctx       The context to pass to @p reduce and @p combine.
+ *
+ * @return     TRUE if the reduction succeeded. FALSE otherwise.
+ */
+extern int (_impl_vec_parallel_reduce)(vec_thread_pool *pool, const _IMPL_VEC_STRUCT_NAME *vec_ptr, void *acc, size_t acc_size,
+                                       _impl_vec_reduce_fn reduce, _impl_vec_combine_fn combine, void *ctx);
+
+/****************************************************************************************
+  External Function Declarations
+ ***************************************************************************************/
+/**
+ * @brief   Initializes a thread pool
+ *
+ * @param[in] pool      Pointer to a thread pool structure.
+ * @param[in] threads   The amount of threads to split the work between, including the thread
+ *                      that uses the pool (so one less worker thread is started).
+ *
+ * @return    TRUE if the initialization succeeded. FALSE otherwise.
+ */
+extern int (vec_thread_pool_init)(vec_thread_pool *pool, unsigned int threads);
+
+/**
+ * @brief   Stops the threads of a thread pool and releases its resources
+ *
+ * @param[in] pool      Pointer to a thread pool structure.
+ */
+extern void (vec_thread_pool_release)(vec_thread_pool *pool);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+/****************************************************************************************
+  External Macro Definitions
+ ***************************************************************************************/
+#define vec_sort_parallel(type) _VEC_CAT(_vec_sort_parallel, type)
+#define vec_parallel_for(type) _VEC_CAT(_vec_parallel_for, type)
+#define vec_parallel_reduce(type) _VEC_CAT(_vec_parallel_reduce, type)
+#define vec_parallel_map(from, to) _VEC_CAT(_VEC_CAT(_vec_parallel_map, from), _VEC_CAT(_to_, to))
+
+/**
+ * Defines the multi-threaded functions of a <code>vec</code> of type <code>type</code>
+ * (which must have been declared with <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_parallel(type) \
+    /**
+     * @brief   Sorts a <code>vec</code> using multiple threads
+     *
+     * @param[in]  pool     Pointer to a thread pool to run the sort on, or NULL to start
+     *                      threads for it.
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  cmpfn    Pointer to comparer function for type <code>type</code>.
+     * @param[in]  threads  The amount of threads to sort with.
+     *
+     * @return    TRUE if the sort succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_sort_parallel, type)(vec_thread_pool *pool, vec_type(type) *vec_ptr, vec_cmp_type(type) cmpfn, unsigned int threads) { \
+        return (_impl_vec_sort_parallel)(pool, (_IMPL_VEC_STRUCT_NAME *)vec_ptr, (_IMPL_VEC_CMPFN_NAME)cmpfn, threads); \
+    } \
+    /**
+     * @brief   Calls a function on the chunks of a <code>vec</code> using a thread pool
+     *
+     * @param[in]  pool     Pointer to a thread pool, or NULL to run on the calling thread.
+     * @param[in]  vec_ptr  Pointer to a <code>vec</code> structure.
+     * @param[in]  fn       The function to call with each chunk of contiguous elements,
+     *                      the index of its first element and its length.
+     * @param[in]  ctx      The context to pass to @p fn.
+     *
+     * @return    TRUE if @p fn was called on all the elements. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_parallel_for, type)(vec_thread_pool *pool, vec_type(type) *vec_ptr, \
+                                                 void (*fn)(type *elems, vec_size_t idx, vec_size_t len, void *ctx), void *ctx) { \
+        return (_impl_vec_parallel_for)(pool, (_IMPL_VEC_STRUCT_NAME *)vec_ptr, (_impl_vec_for_fn)fn, ctx); \
+    } \
+    /**
+     * @brief   Reduces the elements of a <code>vec</code> to a single value using a thread pool
+     *
+     * @param[in]     pool      Pointer to a thread pool, or NULL to run on the calling thread.
+     * @param[in]     vec_ptr   Pointer to a <code>vec</code> structure.
+     * @param[in,out] acc       The identity value of the reduction on input, and its result on output.
+     * @param[in]     acc_size  The size of the value pointed by @p acc.
+     * @param[in]     reduce    The function that accumulates a chunk of contiguous elements into
+     *                          a copy of the identity value.
+     * @param[in]     combine   The function that accumulates the partial results of the chunks
+     *                          into @p acc, in the order of the chunks.
+     * @param[in]     ctx       The context to pass to @p reduce and @p combine.
+     *
+     * @return    TRUE if the reduction succeeded. FALSE otherwise.
+     */ \
+    static int _VEC_CAT(_vec_parallel_reduce, type)(vec_thread_pool *pool, const vec_type(type) *vec_ptr, void *acc, size_t acc_size, \
+                                                    void (*reduce)(void *acc, const type *elems, vec_size_t len, void *ctx), \
+                                                    void (*combine)(void *acc, const void *partial, void *ctx), void *ctx) { \
+        return (_impl_vec_parallel_reduce)(pool, (const _IMPL_VEC_STRUCT_NAME *)vec_ptr, acc, acc_size, \
+                                           (_impl_vec_reduce_fn)reduce, (_impl_vec_combine_fn)combine, ctx); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_parallel declaration.
+     */ \
+    typedef vec_cmp_type(type) *_VEC_CAT(_p_parallel, vec_cmp_type(type))
+
+/**
+ * Defines the parallel transformation of a <code>vec</code> of type <code>from</code> into
+ * a <code>vec</code> of type <code>to</code> (which both must have been declared with
+ * <code>using_vec_type</code> beforehand).
+ */
+#define using_vec_parallel_map(from, to) \
+    /**
+     * @brief   Transforms the elements of a <code>vec</code> into another one using a thread pool
+     *
+     * @param[in]  pool     Pointer to a thread pool, or NULL to run on the calling thread.
+     * @param[in]  src_ptr  Pointer to the <code>vec</code> structure to transform.
+     * @param[in]  dst_ptr  Pointer to a <code>vec</code> structure of the same size to store
+     *                      the transformed elements in.
+     * @param[in]  fn       The function to call with each pair of chunks of contiguous elements
+     *                      at the same indices and their length.
+     * @param[in]  ctx      The context to pass to @p fn.
+     *
+     * @return    TRUE if all the elements were transformed. FALSE otherwise.
+     */ \
+    static int vec_parallel_map(from, to)(vec_thread_pool *pool, const vec_type(from) *src_ptr, vec_type(to) *dst_ptr, \
+                                          void (*fn)(const from *src, to *dst, vec_size_t len, void *ctx), void *ctx) { \
+        return (_impl_vec_parallel_map)(pool, (const _IMPL_VEC_STRUCT_NAME *)src_ptr, (_IMPL_VEC_STRUCT_NAME *)dst_ptr, (_impl_vec_map_fn)fn, ctx); \
+    } \
+    /*
+     * Add a dummy typedef to require insertion of a semicolon after a using_vec_parallel_map declaration.
+     */ \
+    typedef vec_cmp_type(to) *_VEC_CAT(_p_, vec_parallel_map(from, to))
+
+#endif /* !_GENERIC_CVEC_THREAD_H_ */
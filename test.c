@@ -1,140 +1,1969 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include "cvec.h"
-
-using_vec_type(int);
-
-int cmp(const int *a, const int *b)
-{
-    if (*a > *b)
-    {
-        return 1;
-    }
-
-    if (*a == *b)
-    {
-        return 0;
-    }
-
-    return -1;
-}
-
-int main()
-{
-    int result = EXIT_FAILURE;
-
-    vec_type(int) test_vec;
-
-    puts("Hello, world!");
-
-    if (!vec_init(int)(&test_vec))
-    {
-        puts("FAIL: vec_init");
-    }
-    else
-    {
-        unsigned int i = 0;
-        int success = 1, prev = 0;
-
-        for (i = 1; success && i <= 10; ++i)
-        {
-            success = vec_push(int)(&test_vec, i);
-        }
-
-        if (!success)
-        {
-            puts("FAIL: vec_push");
-            goto done;
-        }
-
-        for (i = 0; success && i < 3; ++i)
-        {
-            success = vec_unshift(int)(&test_vec, NULL);
-        }
-
-        if (!success)
-        {
-            puts("FAIL: vec_unshift");
-            goto done;
-        }
-
-        for (i = 13; success && i >= 11; --i)
-        {
-            success = vec_push(int)(&test_vec, i);
-        }
-
-        if (!success)
-        {
-            puts("FAIL: second vec_push");
-            goto done;
-        }
-
-        for (i = 3; success && i < 5; ++i)
-        {
-            int j = 0;
-            success = vec_erase(int)(&test_vec, i, 1, &j);
-        }
-
-        if (!success)
-        {
-            puts("FAIL: vec_erase");
-            goto done;
-        }
-
-        for (i = 0; success && i < 3; ++i)
-        {
-            success = vec_unshift(int)(&test_vec, NULL);
-        }
-
-        if (!success)
-        {
-            puts("FAIL: second vec_unshift");
-            goto done;
-        }
-
-        prev = *vec_get(int)(&test_vec, 0);
-        printf("Before sort: [%d", prev);
-        for (i = 1; i < vec_size(int)(&test_vec); ++i)
-        {
-            int current = *vec_get(int)(&test_vec, i);
-            printf(", %d", current);
-            success = success || prev > current;
-            prev = current;
-        }
-        puts("]");
-
-        if (!success)
-        {
-            puts("FAIL: vector is already sorted");
-            goto done;
-        }
-
-        vec_sort(int)(&test_vec, cmp);
-
-        prev = *vec_get(int)(&test_vec, 0);
-        printf("After sort: [%d", prev);
-        for (i = 1; i < vec_size(int)(&test_vec); ++i)
-        {
-            int current = *vec_get(int)(&test_vec, i);
-            printf(", %d", current);
-            success = success && prev <= current;
-            prev = current;
-        }
-        puts("]");
-
-        if (!success)
-        {
-            puts("ERROR: vec_sort failed");
-            goto done;
-        }
-
-        result = EXIT_SUCCESS;
-
-done:
-        vec_clear(int)(&test_vec);
-
-        puts("Done.");
-    }
-
-    return result;
-}
+#ifndef _WIN32
+#   define _XOPEN_SOURCE 600
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef CVEC_UNCHECKED_ACCESSORS
+#   define CVEC_UNCHECKED_ACCESSORS
+#endif
+#include "cvec.h"
+#include "cvec_concurrent.h"
+
+#ifndef _WIN32
+#   include <pthread.h>
+#   include <sched.h>
+#   include <errno.h>
+#   include <unistd.h>
+#   include <sys/stat.h>
+#   include "cvec_io.h"
+#   include "cvec_thread.h"
+#endif
+
+using_vec_type(int);
+using_vec_sort(int, *a < *b);
+using_vec_type(char);
+using_vec_type_sbo(int, 8);
+using_vec_type_sbo(int, 12);
+
+typedef struct record
+{
+    unsigned int id;
+    char payload[200];
+} record;
+
+using_vec_type(record);
+
+typedef struct pair
+{
+    int key;
+    unsigned int seq;
+} pair;
+
+using_vec_type(pair);
+
+static unsigned long pair_cmp_count = 0;
+
+int pair_cmp(const pair *a, const pair *b)
+{
+    ++pair_cmp_count;
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+using_vec_spsc(int);
+using_vec_mpmc(record);
+using_vec_mpmc(int);
+using_vec_concurrent(int);
+
+#ifndef _WIN32
+using_vec_io(char);
+using_vec_mapped(int);
+using_vec_mapped(record);
+using_vec_snapshot(record);
+using_vec_snapshot(int);
+using_vec_parallel(int);
+using_vec_parallel_map(int, char);
+#endif
+
+int cmp(const int *a, const int *b)
+{
+    if (*a > *b)
+    {
+        return 1;
+    }
+
+    if (*a == *b)
+    {
+        return 0;
+    }
+
+    return -1;
+}
+
+static int test_wrapped_growth(void)
+{
+    int success = 1;
+    unsigned int i = 0;
+    vec_type(int) v;
+
+    vec_init(int)(&v);
+
+    /* Make the elements circulate around the end of the buffer before growing it */
+    for (i = 0; success && i < 10; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    for (i = 0; success && i < 8; ++i)
+    {
+        success = vec_unshift(int)(&v, NULL);
+    }
+
+    for (i = 10; success && i < 100; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_size(int)(&v) == 92;
+
+    for (i = 0; success && i < vec_size(int)(&v); ++i)
+    {
+        success = *vec_get(int)(&v, i) == (int)(i + 8);
+    }
+
+#ifdef CVEC_POW2_CAPACITY
+    success = success && vec_reserve(int)(&v, 200) && vec_capacity(int)(&v) == 256;
+#endif
+
+    /* Grow a vector that isn't full by less than the amount of elements beyond the buffer end */
+    vec_clear(int)(&v);
+    success = success && vec_reserve(int)(&v, 16);
+
+    for (i = 0; success && i < 16; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_unshiftarr(int)(&v, 12, NULL);
+
+    for (i = 16; success && i < 24; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_size(int)(&v) == 12 && vec_reserve(int)(&v, 17);
+
+    for (i = 0; success && i < 12; ++i)
+    {
+        success = *vec_get(int)(&v, i) == (int)(i + 12);
+    }
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_unchecked_accessors(void)
+{
+    int success = 1;
+    unsigned int i = 0;
+    vec_type(int) v;
+
+    vec_init(int)(&v);
+    success = vec_reserve(int)(&v, 16);
+
+    for (i = 0; success && i < 16; ++i)
+    {
+        vec_push_unchecked(int)(&v, i);
+    }
+
+    /* Make the elements circulate around the end of the buffer */
+    success = success && vec_unshiftarr(int)(&v, 4, NULL);
+
+    for (i = 0; success && i < 4; ++i)
+    {
+        vec_push_unchecked(int)(&v, 16 + i);
+    }
+
+    vec_assign_unchecked(int)(&v, 0, -1);
+    success = success && *vec_first_unchecked(int)(&v) == -1 && *vec_get(int)(&v, 0) == -1;
+    success = success && *vec_last_unchecked(int)(&v) == 19 && vec_size(int)(&v) == 16;
+
+    for (i = 1; success && i < vec_size(int)(&v); ++i)
+    {
+        success = *vec_get_unchecked(int)(&v, i) == (int)(i + 4);
+    }
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_middle_edits(void)
+{
+    int success = 1;
+    int ref[1024];
+    int tmp[64];
+    unsigned int ref_size = 0;
+    unsigned int i = 0, round = 0;
+    vec_type(int) v;
+
+    vec_init(int)(&v);
+    srand(1);
+
+    /* Mirror random insertions and removals at random positions on a plain array */
+    for (round = 0; success && round < 2000; ++round)
+    {
+        unsigned int len = (unsigned int)rand() % 64;
+        unsigned int idx = (unsigned int)rand() % (ref_size + 1);
+
+        if ((ref_size + len <= sizeof(ref) / sizeof(ref[0])) && (rand() % 2))
+        {
+            for (i = 0; i < len; ++i)
+            {
+                tmp[i] = (int)round * 100 + (int)i;
+            }
+
+            for (i = ref_size; i > idx; --i)
+            {
+                ref[i - 1 + len] = ref[i - 1];
+            }
+
+            for (i = 0; i < len; ++i)
+            {
+                ref[idx + i] = tmp[i];
+            }
+
+            ref_size += len;
+            success = vec_insertarr(int)(&v, tmp, idx, len);
+        }
+        else
+        {
+            if (len > ref_size - idx)
+            {
+                len = ref_size - idx;
+            }
+
+            success = vec_erase(int)(&v, idx, len, tmp);
+
+            for (i = 0; success && i < len; ++i)
+            {
+                success = tmp[i] == ref[idx + i];
+            }
+
+            for (i = idx; i + len < ref_size; ++i)
+            {
+                ref[i] = ref[i + len];
+            }
+
+            ref_size -= len;
+        }
+
+        success = success && vec_size(int)(&v) == ref_size;
+
+        for (i = 0; success && i < ref_size; ++i)
+        {
+            success = *vec_get(int)(&v, i) == ref[i];
+        }
+    }
+
+    success = success && vec_poparr(int)(&v, 2, tmp) && tmp[1] == ref[ref_size - 1];
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_arena_allocator(void)
+{
+    int success = 1;
+    unsigned int i = 0, j = 0;
+    vec_arena arena;
+    vec_type(int) v[4];
+
+    success = vec_arena_init(&arena, 256);
+
+    for (j = 0; success && j < 4; ++j)
+    {
+        success = vec_init_with_alloc(int)(&v[j], &arena.allocator);
+    }
+
+    /* Interleave the growth of the vecs so some grow in place and some move */
+    for (i = 0; success && i < 500; ++i)
+    {
+        for (j = 0; success && j < 4; ++j)
+        {
+            success = vec_push(int)(&v[j], (int)(i * 4 + j));
+        }
+
+        if (success && i % 7 == 0)
+        {
+            success = vec_unshift(int)(&v[i % 4], NULL) && vec_shift(int)(&v[i % 4], (int)(i % 4));
+        }
+    }
+
+    for (j = 0; success && j < 4; ++j)
+    {
+        for (i = 0; success && i < 500; ++i)
+        {
+            success = *vec_get(int)(&v[j], i) == (int)(i * 4 + j);
+        }
+    }
+
+    /* Clearing keeps the allocator so the vec can be reused */
+    vec_clear(int)(&v[0]);
+    success = success && vec_push(int)(&v[0], 1) && v[0]._alloc == &arena.allocator;
+
+    vec_arena_release(&arena);
+    return success;
+}
+
+static int test_growth_policy(void)
+{
+    int success = 1;
+    unsigned int i = 0;
+    vec_type(int) v;
+    vec_growth_policy policy = { 3, 2, 4, 16, 0, 0 };
+    vec_growth_policy rounded = { 2, 1, 0, 0, 64, 0 };
+    vec_growth_policy invalid = { 1, 1, 0, 0, 0, 0 };
+
+    vec_init(int)(&v);
+    success = vec_set_growth(int)(&v, &policy) && !vec_set_growth(int)(&v, &invalid);
+
+    /* 4, 6, 9, 13, 19, 28, 42, 58, 74, 90, 106 */
+    for (i = 0; success && i < 100; ++i)
+    {
+        success = vec_push(int)(&v, i);
+
+        if (success && i == 0)
+        {
+            success = vec_capacity(int)(&v) == 4;
+        }
+    }
+
+#ifndef CVEC_POW2_CAPACITY
+    success = success && vec_capacity(int)(&v) == 106;
+#endif
+
+    /* The growth policy is kept when clearing the vec */
+    vec_clear(int)(&v);
+    success = success && vec_push(int)(&v, 1) && vec_capacity(int)(&v) == 4;
+
+    /* Reservations are rounded to the granularity */
+    success = success && vec_set_growth(int)(&v, &rounded) && vec_reserve(int)(&v, 10);
+    success = success && vec_capacity(int)(&v) * sizeof(int) == 64;
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_shrink(void)
+{
+    int success = 1;
+    unsigned int i = 0;
+    vec_type(int) v;
+    vec_growth_policy policy = { 2, 1, 8, 0, 0, 4 };
+
+    vec_init(int)(&v);
+
+    for (i = 0; success && i < 1000; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    /* Make the elements circulate around the end of the buffer before shrinking it */
+    success = success && vec_unshiftarr(int)(&v, 990, NULL);
+
+    for (i = 1000; success && i < 1010; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_shrink_to_fit(int)(&v) && vec_capacity(int)(&v) <= 32;
+
+    for (i = 0; success && i < vec_size(int)(&v); ++i)
+    {
+        success = *vec_get(int)(&v, i) == (int)(i + 990);
+    }
+
+    /* An empty vec gives back all of its memory */
+    success = success && vec_poparr(int)(&v, 20, NULL) && vec_shrink_to_fit(int)(&v) && !vec_capacity(int)(&v);
+
+    /* Drain the vec with automatic shrinking */
+    success = success && vec_set_growth(int)(&v, &policy);
+
+    for (i = 0; success && i < 1000; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    for (i = 0; success && i < 990; ++i)
+    {
+        success = vec_unshift(int)(&v, NULL) && vec_size(int)(&v) * 4 >= vec_capacity(int)(&v) / 2;
+    }
+
+    success = success && vec_capacity(int)(&v) < 64;
+
+    for (i = 0; success && i < vec_size(int)(&v); ++i)
+    {
+        success = *vec_get(int)(&v, i) == (int)(i + 990);
+    }
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_introsort(void)
+{
+    int success = 1;
+    unsigned int i = 0, round = 0;
+    vec_type(int) v, ref;
+
+    vec_init(int)(&v);
+    vec_init(int)(&ref);
+    srand(2);
+
+    /* Random, few distinct, sorted and reversed inputs */
+    for (round = 0; success && round < 4; ++round)
+    {
+        vec_clear(int)(&v);
+        vec_clear(int)(&ref);
+
+        for (i = 0; success && i < 10000; ++i)
+        {
+            int val = (round == 0 ? rand() : round == 1 ? rand() % 8 : round == 2 ? (int)i : -(int)i);
+            success = vec_push(int)(&v, val) && vec_push(int)(&ref, val);
+        }
+
+        /* Make the elements circulate around the end of the buffer */
+        success = success && vec_unshiftarr(int)(&v, 100, NULL) && vec_unshiftarr(int)(&ref, 100, NULL);
+        success = success && vec_push(int)(&v, (int)round) && vec_push(int)(&ref, (int)round);
+
+        success = success && vec_introsort(int)(&v) && vec_sort(int)(&ref, cmp);
+        success = success && vec_size(int)(&v) == vec_size(int)(&ref);
+
+        for (i = 0; success && i < vec_size(int)(&v); ++i)
+        {
+            success = *vec_get(int)(&v, i) == *vec_get(int)(&ref, i);
+        }
+    }
+
+    vec_clear(int)(&v);
+    vec_clear(int)(&ref);
+    return success && vec_introsort(int)(&v);
+}
+
+static int test_data(void)
+{
+    static const unsigned int heads[] = { 1, 10, 200, 500, 700, 990 };
+    static const unsigned int tails[] = { 1, 5, 200, 290, 500, 990 };
+    int success = 1;
+    unsigned int i = 0, h = 0, t = 0;
+    vec_type(int) v;
+    int *data;
+
+    vec_init(int)(&v);
+    success = !vec_data(int)(&v);
+
+    /* Align rings with different lengths of the blocks before and after the buffer end */
+    for (h = 0; success && h < sizeof(heads) / sizeof(heads[0]); ++h)
+    {
+        for (t = 0; success && t < sizeof(tails) / sizeof(tails[0]); ++t)
+        {
+            vec_clear(int)(&v);
+            success = vec_reserve(int)(&v, 1000);
+
+            for (i = 0; success && i < vec_capacity(int)(&v); ++i)
+            {
+                success = vec_push(int)(&v, i);
+            }
+
+            success = success && vec_unshiftarr(int)(&v, vec_capacity(int)(&v) - heads[h], NULL);
+
+            for (i = 0; success && i < tails[t] && i < vec_capacity(int)(&v) - heads[h]; ++i)
+            {
+                success = vec_push(int)(&v, vec_capacity(int)(&v) + i);
+            }
+
+            data = vec_data(int)(&v);
+            success = success && data && data == vec_first(int)(&v);
+
+            for (i = 0; success && i < vec_size(int)(&v); ++i)
+            {
+                success = data[i] == (int)(vec_capacity(int)(&v) - heads[h] + i);
+            }
+        }
+    }
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_segments(void)
+{
+    int success = 1;
+    unsigned int i = 0, count = 0, n = 0;
+    vec_type(int) v;
+    vec_span_type(int) spans[2];
+    vec_slice_type(int) slice;
+
+    vec_init(int)(&v);
+    success = vec_segments(int)(&v, spans) == 0 && vec_reserve(int)(&v, 16);
+
+    for (i = 0; success && i < vec_capacity(int)(&v); ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_segments(int)(&v, spans) == 1 && spans[0].size == vec_size(int)(&v);
+
+    /* Make the elements circulate around the end of the buffer */
+    success = success && vec_unshiftarr(int)(&v, 10, NULL);
+
+    for (i = 0; success && i < 4; ++i)
+    {
+        success = vec_push(int)(&v, vec_capacity(int)(&v) + i);
+    }
+
+    success = success && vec_segments(int)(&v, spans) == 2 && spans[0].size + spans[1].size == vec_size(int)(&v);
+
+    for (count = 0, n = 0; success && count < 2; ++count)
+    {
+        for (i = 0; success && i < spans[count].size; ++i, ++n)
+        {
+            success = spans[count].data[i] == *vec_get(int)(&v, n);
+        }
+    }
+
+    /* Slices across and before the buffer end */
+    success = success && vec_slice(int)(&v, 1, vec_size(int)(&v) - 2, &slice);
+
+    for (i = 0; success && i < slice.size; ++i)
+    {
+        success = vec_slice_get(int)(&slice, i) == vec_get(int)(&v, i + 1);
+    }
+
+    success = success && !vec_slice_get(int)(&slice, slice.size);
+    success = success && vec_slice(int)(&v, 0, 2, &slice) && !slice.seg[1].size && *vec_slice_get(int)(&slice, 1) == 11;
+    success = success && !vec_slice(int)(&v, 1, vec_size(int)(&v), &slice);
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_stable_sort(void)
+{
+    int success = 1;
+    unsigned int i = 0, round = 0, count = 0;
+    vec_type(pair) v, scratch;
+
+    vec_init(pair)(&v);
+    vec_init(pair)(&scratch);
+    srand(3);
+
+    /* Few distinct, nearly sorted, descending with duplicates and tiny inputs */
+    for (round = 0; success && round < 8; ++round)
+    {
+        count = (round >= 6 ? round - 5 : 5000);
+        vec_clear(pair)(&v);
+
+        for (i = 0; success && i < count; ++i)
+        {
+            pair p;
+            p.key = (round % 3 == 0 ? rand() % 16 : round % 3 == 1 ? (int)i : -(int)(i / 4));
+            p.seq = i;
+            success = vec_push(pair)(&v, p);
+        }
+
+        if (round % 3 == 1)
+        {
+            for (i = 0; success && i < 10; ++i)
+            {
+                success = vec_swap(pair)(&v, (unsigned int)rand() % count, (unsigned int)rand() % count);
+            }
+        }
+
+        /* Make the elements circulate around the end of the buffer */
+        success = success && vec_unshiftarr(pair)(&v, count / 2, NULL);
+
+        for (i = 0; success && i < count / 2; ++i)
+        {
+            pair p;
+            p.key = rand() % 16;
+            p.seq = count + i;
+            success = vec_push(pair)(&v, p);
+        }
+
+        success = success && vec_stable_sort(pair)(&v, pair_cmp, (round & 1 ? &scratch : NULL));
+
+        for (i = 1; success && i < vec_size(pair)(&v); ++i)
+        {
+            const pair *prev = vec_get(pair)(&v, i - 1), *curr = vec_get(pair)(&v, i);
+            success = prev->key < curr->key || (prev->key == curr->key && prev->seq < curr->seq);
+        }
+    }
+
+    /* Sorted input is detected as a single run */
+    pair_cmp_count = 0;
+    success = success && vec_stable_sort(pair)(&v, pair_cmp, &scratch) && pair_cmp_count < 2 * vec_size(pair)(&v);
+    success = success && !vec_stable_sort(pair)(&v, pair_cmp, &v);
+
+    vec_clear(pair)(&v);
+    vec_clear(pair)(&scratch);
+    return success;
+}
+
+static int test_sorted_search(void)
+{
+    int success = 1, val = 0;
+    unsigned int i = 0;
+    vec_size_t lo = 0, hi = 0;
+    vec_type(int) v;
+
+    vec_init(int)(&v);
+    srand(4);
+
+    /* Keep the vec as a sorted multiset, with the elements circulating around the buffer end */
+    success = vec_reserve(int)(&v, 64);
+
+    for (i = 0; success && i < 40; ++i)
+    {
+        success = vec_push(int)(&v, -1000);
+    }
+
+    success = success && vec_unshiftarr(int)(&v, 40, NULL);
+
+    for (i = 0; success && i < 1000; ++i)
+    {
+        val = rand() % 100;
+        success = vec_insert_sorted(int)(&v, &val, cmp);
+    }
+
+    for (i = 1; success && i < vec_size(int)(&v); ++i)
+    {
+        success = *vec_get(int)(&v, i - 1) <= *vec_get(int)(&v, i);
+    }
+
+    for (val = -1; success && val <= 100; ++val)
+    {
+        lo = vec_lower_bound(int)(&v, &val, cmp);
+        hi = vec_upper_bound(int)(&v, &val, cmp);
+
+        success = lo <= hi && hi <= vec_size(int)(&v);
+        success = success && (!lo || *vec_get(int)(&v, lo - 1) < val) && (lo == hi || *vec_get(int)(&v, lo) == val);
+        success = success && (hi == vec_size(int)(&v) || *vec_get(int)(&v, hi) > val);
+        success = success && (lo == hi ? !vec_bsearch(int)(&v, &val, cmp) : vec_bsearch(int)(&v, &val, cmp) == vec_get(int)(&v, lo));
+    }
+
+    success = success && !vec_bsearch(int)(&v, NULL, cmp) && !vec_insert_sorted(int)(&v, &val, NULL);
+
+    vec_clear(int)(&v);
+    return success;
+}
+
+static int test_spsc_queue(void)
+{
+    int success = 1, vals[10], out[10];
+    unsigned int i = 0, round = 0;
+    vec_spsc_type(int) q;
+
+    success = vec_spsc_init(int)(&q, 6, NULL) && q.capacity == 8 && !vec_spsc_try_pop(int)(&q, out);
+
+    for (i = 0; i < 10; ++i)
+    {
+        vals[i] = (int)i;
+    }
+
+    /* Fill and drain the queue repeatedly so the values circulate around the buffer end */
+    for (round = 0; success && round < 5; ++round)
+    {
+        success = vec_spsc_push_batch(int)(&q, vals, 5) == 5 && vec_spsc_try_push(int)(&q, &vals[5]);
+        success = success && vec_spsc_push_batch(int)(&q, &vals[6], 4) == 2 && !vec_spsc_try_push(int)(&q, vals);
+        success = success && vec_spsc_size(int)(&q) == 8;
+        success = success && vec_spsc_try_pop(int)(&q, out) && out[0] == 0;
+        success = success && vec_spsc_pop_batch(int)(&q, out, 10) == 7 && vec_spsc_size(int)(&q) == 0;
+
+        for (i = 0; success && i < 7; ++i)
+        {
+            success = out[i] == (int)i + 1;
+        }
+    }
+
+    vec_spsc_release(int)(&q);
+    return success && !vec_spsc_init(int)(&q, 0, NULL) && !vec_spsc_try_push(int)(&q, vals);
+}
+
+static int test_mpmc_queue(void)
+{
+    int success = 1, val = 0;
+    unsigned int i = 0, round = 0;
+    record rec, out;
+    vec_mpmc_type(record) q;
+    vec_mpmc_type(int) iq;
+
+    memset(&rec, 0, sizeof(rec));
+    success = vec_mpmc_init(record)(&q, 5, NULL) && q.capacity == 8 && !vec_mpmc_try_pop(record)(&q, &out);
+
+    /* Fill and drain the queue repeatedly so the positions go around the slots several times */
+    for (round = 0; success && round < 5; ++round)
+    {
+        for (i = 0; success && i < 8; ++i)
+        {
+            rec.id = round * 8 + i;
+            rec.payload[sizeof(rec.payload) - 1] = (char)i;
+            success = (i & 1 ? vec_mpmc_push(record)(&q, &rec) : vec_mpmc_try_push(record)(&q, &rec));
+        }
+
+        success = success && !vec_mpmc_try_push(record)(&q, &rec) && vec_mpmc_size(record)(&q) == 8;
+
+        for (i = 0; success && i < 8; ++i)
+        {
+            success = (i & 1 ? vec_mpmc_pop(record)(&q, &out) : vec_mpmc_try_pop(record)(&q, &out));
+            success = success && out.id == round * 8 + i && out.payload[sizeof(out.payload) - 1] == (char)i;
+        }
+
+        success = success && !vec_mpmc_try_pop(record)(&q, &out) && vec_mpmc_size(record)(&q) == 0;
+    }
+
+    vec_mpmc_release(record)(&q);
+
+    /* A single requested slot still gets two, so that full and empty slots can be told apart */
+    success = success && vec_mpmc_init(int)(&iq, 1, NULL) && iq.capacity == 2;
+    vec_mpmc_release(int)(&iq);
+    return success && !vec_mpmc_init(int)(&iq, 0, NULL) && !vec_mpmc_try_push(int)(&iq, &val);
+}
+
+/* An allocator that fails once it handed out the amount of allocations its context points to */
+static void* limited_alloc(void *ctx, size_t size)
+{
+    unsigned int *left = (unsigned int *)ctx;
+
+    if (!*left)
+    {
+        return NULL;
+    }
+
+    --*left;
+    return malloc(size);
+}
+
+static void* limited_realloc(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    (void)ctx;
+    (void)old_size;
+    return realloc(ptr, new_size);
+}
+
+static void limited_free(void *ctx, void *ptr, size_t size)
+{
+    (void)ctx;
+    (void)size;
+    free(ptr);
+}
+
+static int test_concurrent_vec(void)
+{
+    int success = 1, val = 0;
+    int *first = NULL, *elem = NULL;
+    unsigned int allocs = 0;
+    vec_allocator limited;
+    vec_concurrent_type(int) v;
+
+    limited.alloc_fn = limited_alloc;
+    limited.realloc_fn = limited_realloc;
+    limited.free_fn = limited_free;
+    limited.ctx = &allocs;
+    limited.file_backed = FALSE;
+
+    success = vec_concurrent_init(int)(&v, 3, NULL) && !vec_concurrent_get(int)(&v, 0);
+
+    /* Growing through several segments must not move the elements that were already appended */
+    for (val = 0; success && val < 1000; ++val)
+    {
+        success = (elem = vec_concurrent_push(int)(&v, &val)) != NULL && *elem == val;
+        first = (val ? first : elem);
+    }
+
+    success = success && vec_concurrent_size(int)(&v) == 1000 && first == vec_concurrent_get(int)(&v, 0) && *first == 0;
+
+    for (val = 0; success && val < 1000; ++val)
+    {
+        success = (elem = vec_concurrent_get(int)(&v, (vec_size_t)val)) != NULL && *elem == val;
+    }
+
+    success = success && !vec_concurrent_get(int)(&v, 1000);
+    vec_concurrent_release(int)(&v);
+    success = success && !vec_concurrent_push(int)(&v, &val) && vec_concurrent_size(int)(&v) == 0;
+
+    /* Failing to allocate the second segment stops the vector at its first index */
+    allocs = 1;
+    success = success && vec_concurrent_init(int)(&v, 4, &limited);
+
+    for (val = 0; success && val < 4; ++val)
+    {
+        success = vec_concurrent_push(int)(&v, &val) != NULL;
+    }
+
+    success = success && !vec_concurrent_push(int)(&v, &val) && !vec_concurrent_push(int)(&v, &val);
+    success = success && vec_concurrent_size(int)(&v) == 4 && *vec_concurrent_get(int)(&v, 3) == 3;
+    vec_concurrent_release(int)(&v);
+    return success;
+}
+
+static int test_sbo(void)
+{
+    int success = 1;
+    int i = 0;
+    vec_sbo_type(int, 8) sbo;
+    vec_sbo_type(int, 12) odd;
+
+    success = vec_sbo_init(int, 8)(&sbo) && sbo.vec._mem == sbo._buf && vec_capacity(int)(&sbo.vec) == 8;
+
+    /* Make the elements circulate around the end of the inline buffer before it's outgrown */
+    for (i = 0; success && i < 8; ++i)
+    {
+        success = vec_push(int)(&sbo.vec, i);
+    }
+
+    success = success && vec_unshiftarr(int)(&sbo.vec, 3, NULL) && vec_push(int)(&sbo.vec, 8);
+    success = success && vec_push(int)(&sbo.vec, 9) && vec_push(int)(&sbo.vec, 10) && sbo.vec._mem == sbo._buf;
+    success = success && vec_push(int)(&sbo.vec, 11) && sbo.vec._mem != sbo._buf && vec_size(int)(&sbo.vec) == 9;
+
+    for (i = 0; success && i < 9; ++i)
+    {
+        success = *vec_get(int)(&sbo.vec, (vec_size_t)i) == i + 3;
+    }
+
+    /* Shrinking enough moves the elements back to the inline buffer */
+    success = success && vec_poparr(int)(&sbo.vec, 5, NULL) && vec_shrink_to_fit(int)(&sbo.vec) && sbo.vec._mem == sbo._buf;
+
+    for (i = 0; success && i < 4; ++i)
+    {
+        success = *vec_get(int)(&sbo.vec, (vec_size_t)i) == i + 3;
+    }
+
+    /* The inline buffer is reused once the vector is cleared */
+    vec_clear(int)(&sbo.vec);
+    success = success && !sbo.vec._mem && vec_push(int)(&sbo.vec, 1) && sbo.vec._mem == sbo._buf;
+    vec_clear(int)(&sbo.vec);
+
+    /* A buffer for an amount of elements that isn't a power of two is taken in either capacity mode */
+    success = success && vec_sbo_init(int, 12)(&odd) && odd.vec._mem == odd._buf;
+#ifdef CVEC_POW2_CAPACITY
+    success = success && vec_capacity(int)(&odd.vec) == 8;
+#else
+    success = success && vec_capacity(int)(&odd.vec) == 12;
+#endif
+
+    for (i = 0; success && i < (int)vec_capacity(int)(&odd.vec); ++i)
+    {
+        success = vec_push(int)(&odd.vec, i);
+    }
+
+    success = success && odd.vec._mem == odd._buf;
+    vec_clear(int)(&odd.vec);
+    return success && !vec_sbo_init(int, 8)(NULL);
+}
+
+#ifdef CVEC_STATS
+static int test_stats(void)
+{
+    int success = 1;
+    int i = 0;
+    int *data = NULL;
+    unsigned int allocs = 0;
+    vec_type(int) v, unchecked, limited_vec;
+    vec_allocator limited;
+    vec_statistics stats, global;
+
+    vec_init(int)(&v);
+    success = vec_stats(int)(&v, &stats) && !stats.allocs && !stats.reallocs && !stats.high_water;
+    success = success && vec_reserve(int)(&v, 8) && vec_stats(int)(&v, &stats) && stats.allocs == 1 && !stats.reallocs;
+
+    for (i = 0; success && i < 8; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    /* Pushing after removing from the front makes the elements circulate beyond the buffer end once */
+    success = success && vec_unshiftarr(int)(&v, 3, NULL);
+
+    for (i = 8; success && i < 11; ++i)
+    {
+        success = vec_push(int)(&v, i);
+    }
+
+    success = success && vec_stats(int)(&v, &stats) && stats.wraps == 1 && stats.high_water == 8 && !stats.bytes_moved;
+
+    /* Aligning the full ring moves the part before the buffer end and rotates the whole buffer */
+    success = success && (data = vec_data(int)(&v)) != NULL && vec_stats(int)(&v, &stats);
+    success = success && stats.rotations == 1 && stats.bytes_moved == 13 * sizeof(int);
+
+    for (i = 0; success && i < 8; ++i)
+    {
+        success = data[i] == i + 3;
+    }
+
+    /* Shrinking a ring that circulates copies its elements, and growing a contiguous one reallocates */
+    success = success && vec_unshiftarr(int)(&v, 6, NULL) && vec_push(int)(&v, 11) && vec_push(int)(&v, 12);
+    success = success && vec_shrink_to_fit(int)(&v) && vec_capacity(int)(&v) == 4;
+    success = success && vec_stats(int)(&v, &stats) && stats.wraps == 2 && stats.copies == 1 && stats.allocs == 2;
+    success = success && stats.bytes_moved == 17 * sizeof(int);
+    success = success && vec_reserve(int)(&v, 16) && vec_stats(int)(&v, &stats) && stats.reallocs == 1;
+
+    /* The counters outlive clearing, and the process-wide ones include them */
+    vec_clear(int)(&v);
+    vec_stats_global(&global);
+    success = success && vec_stats(int)(&v, &stats) && stats.allocs == 2 && stats.high_water == 8;
+    success = success && global.allocs >= stats.allocs && global.reallocs >= stats.reallocs && global.copies >= stats.copies;
+    success = success && global.bytes_moved >= stats.bytes_moved && global.wraps >= stats.wraps;
+    success = success && global.rotations >= stats.rotations && global.high_water >= stats.high_water;
+
+    /* Unchecked pushes are counted the same as checked ones */
+    vec_init(int)(&unchecked);
+    success = success && vec_reserve(int)(&unchecked, 8);
+
+    for (i = 0; success && i < 8; ++i)
+    {
+        vec_push_unchecked(int)(&unchecked, i);
+    }
+
+    success = success && vec_unshiftarr(int)(&unchecked, 4, NULL);
+
+    for (i = 0; success && i < 2; ++i)
+    {
+        vec_push_unchecked(int)(&unchecked, i);
+    }
+
+    success = success && vec_stats(int)(&unchecked, &stats) && stats.wraps == 1 && stats.high_water == 8;
+    vec_clear(int)(&unchecked);
+
+    /* Failed allocations and sort scratch aren't counted as buffers of the vector */
+    limited.alloc_fn = limited_alloc;
+    limited.realloc_fn = limited_realloc;
+    limited.free_fn = limited_free;
+    limited.ctx = &allocs;
+    limited.file_backed = FALSE;
+    success = success && vec_init_with_alloc(int)(&limited_vec, &limited) && !vec_reserve(int)(&limited_vec, 8);
+    allocs = 1;
+    success = success && vec_reserve(int)(&limited_vec, 8);
+
+    for (i = 0; success && i < 8; ++i)
+    {
+        success = vec_push(int)(&limited_vec, (i * 5) % 8);
+    }
+
+    success = success && !vec_stable_sort(int)(&limited_vec, cmp, NULL);
+    allocs = 1;
+    success = success && vec_stable_sort(int)(&limited_vec, cmp, NULL) && *vec_first(int)(&limited_vec) == 0;
+    success = success && vec_stats(int)(&limited_vec, &stats) && stats.allocs == 1;
+    vec_clear(int)(&limited_vec);
+
+#ifndef _WIN32
+    /* Elements read from a file descriptor are counted the same as pushed ones */
+    {
+        int fds[2];
+        vec_type(char) bytes;
+
+        if (pipe(fds))
+        {
+            return 0;
+        }
+
+        vec_init(char)(&bytes);
+        success = success && vec_reserve(char)(&bytes, 8) && vec_pusharr(char)(&bytes, "abcdef", 6);
+        success = success && vec_unshiftarr(char)(&bytes, 4, NULL) && write(fds[1], "ghijk", 5) == 5;
+        success = success && vec_read_fd(char)(&bytes, fds[0], 5) == 5 && vec_size(char)(&bytes) == 7;
+        success = success && vec_stats(char)(&bytes, &stats) && stats.wraps == 1 && stats.high_water == 7;
+
+        close(fds[0]);
+        close(fds[1]);
+        vec_clear(char)(&bytes);
+    }
+#endif
+
+    return success && !vec_stats(int)(NULL, &stats) && !vec_stats(int)(&v, NULL);
+}
+#endif /* CVEC_STATS */
+
+static int test_emplace(void)
+{
+    int success = 1;
+    unsigned int i = 0;
+    record *r = NULL;
+    vec_type(record) v;
+    vec_slice_type(record) slice;
+
+    vec_init(record)(&v);
+    success = vec_reserve(record)(&v, 8);
+
+    for (i = 0; success && i < 6; ++i)
+    {
+        success = (r = vec_emplace_back(record)(&v)) != NULL && r == vec_last(record)(&v);
+        if (success)
+        {
+            r->id = i;
+            memset(r->payload, (int)i, sizeof(r->payload));
+        }
+    }
+
+    /* Make room in the front so the appended elements circulate around the buffer end */
+    success = success && vec_unshiftarr(record)(&v, 4, NULL) && vec_capacity(record)(&v) == 8;
+    success = success && vec_extend_uninit(record)(&v, 5, &slice) && slice.size == 5 && slice.seg[1].size;
+    success = success && vec_size(record)(&v) == 7 && vec_capacity(record)(&v) == 8;
+
+    for (i = 0; success && i < slice.size; ++i)
+    {
+        vec_slice_get(record)(&slice, i)->id = 6 + i;
+    }
+
+    for (i = 0; success && i < vec_size(record)(&v); ++i)
+    {
+        success = vec_get(record)(&v, i)->id == 4 + i;
+    }
+
+    success = success && vec_get(record)(&v, 1)->payload[199] == 5;
+
+    /* Extending beyond the capacity grows the vec */
+    success = success && vec_extend_uninit(record)(&v, 10, &slice) && vec_size(record)(&v) == 17;
+    success = success && vec_get(record)(&v, 6)->id == 10;
+    success = success && vec_extend_uninit(record)(&v, 0, &slice) && !slice.size;
+    success = success && !vec_extend_uninit(record)(&v, 1, NULL) && vec_size(record)(&v) == 17;
+
+    vec_clear(record)(&v);
+    return success;
+}
+
+#ifndef _WIN32
+static int test_fd_io(void)
+{
+    static const char msg[] = "scatter/gather";
+    int success = 1, fds[2];
+    char buf[sizeof(msg)];
+    unsigned int i = 0;
+    vec_type(char) v;
+
+    if (pipe(fds))
+    {
+        return 0;
+    }
+
+    vec_init(char)(&v);
+    success = vec_reserve(char)(&v, 16) && vec_pusharr(char)(&v, "0123456789", 10);
+
+    /* Leave a few bytes in the front so the read circulates around the buffer end */
+    success = success && vec_unshiftarr(char)(&v, 8, NULL);
+    success = success && write(fds[1], msg, sizeof(msg) - 1) == (ssize_t)(sizeof(msg) - 1);
+    success = success && vec_read_fd(char)(&v, fds[0], sizeof(msg) - 1) == (ssize_t)(sizeof(msg) - 1);
+    success = success && vec_size(char)(&v) == sizeof(msg) + 1;
+
+    for (i = 0; success && i < sizeof(msg) - 1; ++i)
+    {
+        success = *vec_get(char)(&v, i + 2) == msg[i];
+    }
+
+    /* Drain everything back through the pipe */
+    success = success && vec_write_fd(char)(&v, fds[1]) == (ssize_t)(sizeof(msg) + 1) && vec_empty(char)(&v);
+    success = success && read(fds[0], buf, 2) == 2 && buf[0] == '8' && buf[1] == '9';
+    success = success && read(fds[0], buf, sizeof(msg) - 1) == (ssize_t)(sizeof(msg) - 1);
+    success = success && !memcmp(buf, msg, sizeof(msg) - 1);
+    success = success && vec_write_fd(char)(&v, fds[1]) == 0;
+
+    close(fds[0]);
+    close(fds[1]);
+    vec_clear(char)(&v);
+    return success;
+}
+
+static const vec_mapped *sorted_mapped = NULL;
+static int sorted_mapped_spilled = 0;
+
+/* Compares like cmp(), and notes if sort scratch took up the second region of sorted_mapped */
+int cmp_mapped(const int *a, const int *b)
+{
+    if (sorted_mapped->_regions[0].mem && sorted_mapped->_regions[1].mem)
+    {
+        sorted_mapped_spilled = 1;
+    }
+
+    return cmp(a, b);
+}
+
+static int test_mapped(void)
+{
+    char path[] = "/tmp/cvec_mappedXXXXXX";
+    int success = 1, fd = mkstemp(path);
+    unsigned int i = 0;
+    vec_size_t capacity = 0;
+    vec_mapped_type(int) m;
+    vec_mapped_type(record) wrong;
+    struct stat st;
+
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    close(fd);
+    success = vec_open_mapped(int)(&m, path, VEC_MAPPED_TRUNCATE) && vec_empty(int)(&m.vec);
+
+    for (i = 0; success && i < 10000; ++i)
+    {
+        success = vec_push(int)(&m.vec, (int)i);
+    }
+
+    /* Make the values circulate around the buffer end, and grow the buffer by less than the
+     * amount of values beyond the end, so they're copied to a new region of the file */
+    capacity = vec_capacity(int)(&m.vec);
+    success = success && vec_unshiftarr(int)(&m.vec, 5000, NULL);
+
+    for (i = 10000; success && i < capacity + 1000; ++i)
+    {
+        success = vec_push(int)(&m.vec, (int)i);
+    }
+
+    success = success && vec_reserve(int)(&m.vec, capacity + 1);
+
+    /* Shrinking moves the elements back to the front of the file, and the file shrinks with them */
+    success = success && !stat(path, &st) && (size_t)st.st_size > m._mapped._page + capacity * sizeof(int);
+    success = success && vec_shrink_to_fit(int)(&m.vec) && !stat(path, &st);
+    success = success && (size_t)st.st_size == m._mapped._page + vec_capacity(int)(&m.vec) * sizeof(int);
+    success = success && vec_close_mapped(int)(&m);
+
+    /* The elements survive reopening the file, and growing it after that */
+    success = success && vec_open_mapped(int)(&m, path, 0) && vec_size(int)(&m.vec) == capacity - 4000;
+    success = success && vec_push(int)(&m.vec, -1) && vec_stable_sort(int)(&m.vec, cmp, NULL) && vec_sync_mapped(int)(&m);
+    success = success && vec_close_mapped(int)(&m) && vec_open_mapped(int)(&m, path, 0);
+    success = success && *vec_first(int)(&m.vec) == -1;
+
+    for (i = 1; success && i < vec_size(int)(&m.vec); ++i)
+    {
+        success = *vec_get(int)(&m.vec, i) == (int)(5000 + i - 1);
+    }
+
+    success = success && vec_close_mapped(int)(&m);
+
+    /* Sort scratch isn't allocated in the file */
+    success = success && vec_open_mapped(int)(&m, path, VEC_MAPPED_TRUNCATE);
+    sorted_mapped = &m._mapped;
+    sorted_mapped_spilled = 0;
+
+    for (i = 0; success && i < 40000; ++i)
+    {
+        success = vec_push(int)(&m.vec, (int)((i * 7919) % 40000));
+    }
+
+    success = success && vec_stable_sort(int)(&m.vec, cmp_mapped, NULL);
+
+    for (i = 0; success && i < 40000; ++i)
+    {
+        success = *vec_get(int)(&m.vec, i) == (int)i;
+    }
+
+    for (i = 0; success && i < 40000; ++i)
+    {
+        *vec_get(int)(&m.vec, i) = (int)(39999 - i);
+    }
+
+    success = success && vec_sort_parallel(int)(NULL, &m.vec, cmp_mapped, 4);
+
+    for (i = 0; success && i < 40000; ++i)
+    {
+        success = *vec_get(int)(&m.vec, i) == (int)i;
+    }
+
+    success = success && !sorted_mapped_spilled && vec_close_mapped(int)(&m);
+
+    /* A file of another element size is rejected */
+    success = success && !vec_open_mapped(record)(&wrong, path, 0) && !vec_open_mapped(int)(&m, "/nonexistent/vec", VEC_MAPPED_CREATE);
+    unlink(path);
+    return success;
+}
+
+static int test_snapshot(void)
+{
+    char path[] = "/tmp/cvec_snapshotXXXXXX";
+    int success = 1, fd = mkstemp(path);
+    unsigned int i = 0, parsed = 0;
+    ssize_t count = 0;
+    record rec;
+    vec_type(record) v, loaded;
+    vec_type(int) ints;
+    vec_load_state state;
+
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    unlink(path);
+    vec_init(record)(&v);
+    vec_init(record)(&loaded);
+    vec_init(int)(&ints);
+    memset(&rec, 0, sizeof(rec));
+
+    /* Save a vector whose elements circulate around the buffer end */
+    for (i = 0; success && i < 300; ++i)
+    {
+        rec.id = i;
+        rec.payload[i % sizeof(rec.payload)] = (char)i;
+        success = vec_push(record)(&v, rec);
+    }
+
+    success = success && vec_unshiftarr(record)(&v, 100, NULL);
+
+    for (i = 300; success && i < 350; ++i)
+    {
+        rec.id = i;
+        success = vec_push(record)(&v, rec);
+    }
+
+    success = success && vec_save(record)(&v, fd) && vec_push(record)(&loaded, rec);
+
+    /* Load the snapshot after an existing element, and then in chunks that are checked as they arrive */
+    success = success && lseek(fd, 0, SEEK_SET) == 0 && vec_load(record)(&loaded, fd) && vec_size(record)(&loaded) == 251;
+
+    for (i = 0; success && i < 250; ++i)
+    {
+        success = !memcmp(vec_get(record)(&loaded, i + 1), vec_get(record)(&v, i), sizeof(record));
+    }
+
+    vec_clear(record)(&loaded);
+    success = success && lseek(fd, 0, SEEK_SET) == 0 && vec_load_begin(record)(&loaded, fd, &state);
+    success = success && state.remaining == 250 && vec_capacity(record)(&loaded) >= 250;
+
+    while (success && (count = vec_load_chunk(record)(&loaded, &state, 64)) > 0)
+    {
+        for (; success && parsed < vec_size(record)(&loaded); ++parsed)
+        {
+            success = vec_get(record)(&loaded, parsed)->id == parsed + 100;
+        }
+    }
+
+    success = success && count == 0 && parsed == 250;
+
+    /* A corrupt or truncated snapshot, or one of another element size, isn't loaded */
+    success = success && pwrite(fd, "x", 1, 100) == 1 && lseek(fd, 0, SEEK_SET) == 0;
+    success = success && !vec_load(record)(&loaded, fd) && errno == EBADMSG && vec_size(record)(&loaded) == 250;
+    success = success && lseek(fd, 0, SEEK_SET) == 0 && !vec_load(int)(&ints, fd) && errno == EINVAL;
+    success = success && ftruncate(fd, 1000) == 0 && lseek(fd, 0, SEEK_SET) == 0;
+    success = success && !vec_load(record)(&loaded, fd) && vec_size(record)(&loaded) == 250;
+
+    close(fd);
+    vec_clear(record)(&v);
+    vec_clear(record)(&loaded);
+    vec_clear(int)(&ints);
+    return success;
+}
+
+static int test_sort_parallel(void)
+{
+    static const unsigned int threads[] = { 0, 1, 3, 4, 8, 1000, 3, 4 };
+    int success = 1;
+    unsigned int i = 0, round = 0;
+    vec_type(int) v, ref;
+    vec_thread_pool pool;
+
+    if (!vec_thread_pool_init(&pool, 3))
+    {
+        return 0;
+    }
+
+    vec_init(int)(&v);
+    vec_init(int)(&ref);
+    srand(5);
+
+    /* The last rounds run on a thread pool, one of them with a chunk for every thread */
+    for (round = 0; success && round < sizeof(threads) / sizeof(threads[0]); ++round)
+    {
+        vec_clear(int)(&v);
+        vec_clear(int)(&ref);
+
+        for (i = 0; success && i < 100000; ++i)
+        {
+            int val = (round & 1 ? rand() % 64 : rand());
+            success = vec_push(int)(&v, val) && vec_push(int)(&ref, val);
+        }
+
+        /* Make the elements circulate around the end of the buffer */
+        success = success && vec_unshiftarr(int)(&v, 1000, NULL) && vec_unshiftarr(int)(&ref, 1000, NULL);
+        success = success && vec_push(int)(&v, (int)round) && vec_push(int)(&ref, (int)round);
+
+        success = success && vec_sort_parallel(int)(round >= 6 ? &pool : NULL, &v, cmp, threads[round]);
+        success = success && vec_sort(int)(&ref, cmp);
+        success = success && vec_size(int)(&v) == vec_size(int)(&ref);
+
+        for (i = 0; success && i < vec_size(int)(&v); ++i)
+        {
+            success = *vec_get(int)(&v, i) == *vec_get(int)(&ref, i);
+        }
+    }
+
+    vec_clear(int)(&v);
+    vec_clear(int)(&ref);
+    vec_thread_pool_release(&pool);
+    return success && vec_sort_parallel(int)(NULL, &v, cmp, 4) && !vec_sort_parallel(int)(NULL, NULL, cmp, 4);
+}
+
+#define SPSC_TEST_COUNT 200000
+
+static void* spsc_producer(void *arg)
+{
+    vec_spsc_type(int) *q = (vec_spsc_type(int) *)arg;
+    int vals[16];
+    unsigned int i = 0, j = 0, sent = 0;
+
+    /* Alternate between single and batch pushes, and let the consumer run when the queue is full */
+    while (sent < SPSC_TEST_COUNT)
+    {
+        for (i = 0; i < 16; ++i)
+        {
+            vals[i] = (int)(sent + i);
+        }
+
+        if (sent & 1)
+        {
+            j = (unsigned int)vec_spsc_try_push(int)(q, vals);
+        }
+        else
+        {
+            j = vec_spsc_push_batch(int)(q, vals, (SPSC_TEST_COUNT - sent < 16 ? SPSC_TEST_COUNT - sent : 16));
+        }
+
+        if (!j)
+        {
+            sched_yield();
+        }
+
+        sent += j;
+    }
+
+    return NULL;
+}
+
+static int test_spsc_threads(void)
+{
+    int success = 1, out[7];
+    unsigned int i = 0, received = 0;
+    vec_spsc_type(int) q;
+    pthread_t producer;
+
+    if (!vec_spsc_init(int)(&q, 64, NULL))
+    {
+        return 0;
+    }
+
+    if (pthread_create(&producer, NULL, spsc_producer, &q))
+    {
+        vec_spsc_release(int)(&q);
+        return 0;
+    }
+
+    /* The values must arrive in order, without any of them lost or duplicated */
+    while (received < SPSC_TEST_COUNT)
+    {
+        unsigned int count = vec_spsc_pop_batch(int)(&q, out, received & 1 ? 1 : 7);
+
+        if (!count)
+        {
+            sched_yield();
+        }
+
+        for (i = 0; i < count; ++i, ++received)
+        {
+            success = success && out[i] == (int)received;
+        }
+    }
+
+    pthread_join(producer, NULL);
+    vec_spsc_release(int)(&q);
+    return success;
+}
+
+#define MPMC_TEST_THREADS 4
+#define MPMC_TEST_COUNT 20000
+
+typedef struct
+{
+    vec_mpmc_type(int) *q;
+    unsigned int id;
+} mpmc_producer_arg;
+
+static vec_size_t mpmc_received[MPMC_TEST_THREADS * MPMC_TEST_COUNT];
+
+static void* mpmc_producer(void *arg)
+{
+    vec_mpmc_type(int) *q = ((mpmc_producer_arg *)arg)->q;
+    unsigned int i = 0, id = ((mpmc_producer_arg *)arg)->id;
+    int val = 0;
+
+    /* Every producer pushes its own range of values */
+    for (i = 0; i < MPMC_TEST_COUNT; ++i)
+    {
+        val = (int)(id * MPMC_TEST_COUNT + i);
+
+        if (i & 1)
+        {
+            vec_mpmc_push(int)(q, &val);
+            continue;
+        }
+
+        while (!vec_mpmc_try_push(int)(q, &val))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* mpmc_consumer(void *arg)
+{
+    vec_mpmc_type(int) *q = (vec_mpmc_type(int) *)arg;
+    unsigned int i = 0;
+    int val = 0;
+
+    for (i = 0; i < MPMC_TEST_COUNT; ++i)
+    {
+        if (i & 1)
+        {
+            vec_mpmc_pop(int)(q, &val);
+        }
+        else
+        {
+            while (!vec_mpmc_try_pop(int)(q, &val))
+            {
+                sched_yield();
+            }
+        }
+
+        __atomic_fetch_add(&mpmc_received[val], 1, __ATOMIC_RELAXED);
+    }
+
+    return NULL;
+}
+
+static int test_mpmc_threads(void)
+{
+    int success = 1;
+    unsigned int i = 0, started = 0;
+    vec_mpmc_type(int) q;
+    pthread_t producers[MPMC_TEST_THREADS], consumers[MPMC_TEST_THREADS];
+    mpmc_producer_arg args[MPMC_TEST_THREADS];
+
+    if (!vec_mpmc_init(int)(&q, 16, NULL))
+    {
+        return 0;
+    }
+
+    memset(mpmc_received, 0, sizeof(mpmc_received));
+
+    /* The threads are started in pairs, so the values pushed and popped by the started threads
+     * always balance out. If a consumer can't be started, consume for it on this thread */
+    for (started = 0; started < MPMC_TEST_THREADS; ++started)
+    {
+        args[started].q = &q;
+        args[started].id = started;
+
+        if (pthread_create(&producers[started], NULL, mpmc_producer, &args[started]))
+        {
+            success = 0;
+            break;
+        }
+
+        if (pthread_create(&consumers[started], NULL, mpmc_consumer, &q))
+        {
+            mpmc_consumer(&q);
+            pthread_join(producers[started], NULL);
+            success = 0;
+            break;
+        }
+    }
+
+    for (i = 0; i < started; ++i)
+    {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+    }
+
+    /* Every value must arrive exactly once */
+    for (i = 0; success && i < MPMC_TEST_THREADS * MPMC_TEST_COUNT; ++i)
+    {
+        success = mpmc_received[i] == 1;
+    }
+
+    vec_mpmc_release(int)(&q);
+    return success && vec_mpmc_size(int)(&q) == 0;
+}
+
+#define CONCURRENT_TEST_THREADS 4
+#define CONCURRENT_TEST_COUNT 20000
+
+typedef struct
+{
+    vec_concurrent_type(int) *v;
+    unsigned int id;
+} appender_arg;
+
+static vec_size_t concurrent_received[CONCURRENT_TEST_THREADS * CONCURRENT_TEST_COUNT];
+static unsigned int concurrent_finished;
+
+static void* concurrent_appender(void *arg)
+{
+    appender_arg *a = (appender_arg *)arg;
+    unsigned int i = 0;
+    int val = 0, *elem = NULL;
+
+    for (i = 0; i < CONCURRENT_TEST_COUNT; ++i)
+    {
+        val = (int)(a->id * CONCURRENT_TEST_COUNT + i);
+
+        if (!(elem = vec_concurrent_push(int)(a->v, &val)) || *elem != val)
+        {
+            break;
+        }
+    }
+
+    /* Let the reader know that no more elements are coming from this appender */
+    __atomic_fetch_add(&concurrent_finished, 1, __ATOMIC_RELEASE);
+    return (i < CONCURRENT_TEST_COUNT ? arg : NULL);
+}
+
+static int test_concurrent_vec_threads(void)
+{
+    int success = 1, done = 0, *elem = NULL;
+    unsigned int i = 0, started = 0;
+    vec_size_t size = 0, seen = 0;
+    vec_concurrent_type(int) v;
+    pthread_t appenders[CONCURRENT_TEST_THREADS];
+    appender_arg args[CONCURRENT_TEST_THREADS];
+    void *result = NULL;
+
+    if (!vec_concurrent_init(int)(&v, 8, NULL))
+    {
+        return 0;
+    }
+
+    memset(concurrent_received, 0, sizeof(concurrent_received));
+    concurrent_finished = 0;
+
+    for (started = 0; started < CONCURRENT_TEST_THREADS; ++started)
+    {
+        args[started].v = &v;
+        args[started].id = started;
+
+        if (pthread_create(&appenders[started], NULL, concurrent_appender, &args[started]))
+        {
+            success = 0;
+            break;
+        }
+    }
+
+    /* Read the elements while they're appended. Every published element must be readable.
+     * Stop once every appender finished and nothing is left to read, even if one failed */
+    while (success && seen < CONCURRENT_TEST_THREADS * CONCURRENT_TEST_COUNT)
+    {
+        done = __atomic_load_n(&concurrent_finished, __ATOMIC_ACQUIRE) == started;
+
+        if ((size = vec_concurrent_size(int)(&v)) == seen)
+        {
+            if (done)
+            {
+                success = 0;
+                break;
+            }
+
+            sched_yield();
+        }
+
+        for (; success && seen < size; ++seen)
+        {
+            success = (elem = vec_concurrent_get(int)(&v, seen)) != NULL &&
+                *elem >= 0 && *elem < CONCURRENT_TEST_THREADS * CONCURRENT_TEST_COUNT;
+            success = success && ++concurrent_received[*elem] == 1;
+        }
+    }
+
+    for (i = 0; i < started; ++i)
+    {
+        pthread_join(appenders[i], &result);
+        success = success && !result;
+    }
+
+    vec_concurrent_release(int)(&v);
+    return success;
+}
+
+static void square_chunk(int *elems, vec_size_t idx, vec_size_t len, void *ctx)
+{
+    vec_size_t i = 0;
+
+    for (i = 0; i < len; ++i)
+    {
+        /* Every element holds its index, so a chunk handed out twice or at the wrong index shows */
+        elems[i] = (elems[i] == (int)(idx + i) ? elems[i] % 1000 * (elems[i] % 1000) : -1);
+    }
+
+    (void)ctx;
+}
+
+static void low_bits_chunk(const int *src, char *dst, vec_size_t len, void *ctx)
+{
+    vec_size_t i = 0;
+
+    for (i = 0; i < len; ++i)
+    {
+        dst[i] = (char)(src[i] & 0x7f);
+    }
+
+    (void)ctx;
+}
+
+static void sum_chunk(void *acc, const int *elems, vec_size_t len, void *ctx)
+{
+    vec_size_t i = 0;
+
+    for (i = 0; i < len; ++i)
+    {
+        *(long *)acc += elems[i];
+    }
+
+    (void)ctx;
+}
+
+static void sum_partials(void *acc, const void *partial, void *ctx)
+{
+    *(long *)acc += *(const long *)partial;
+    (void)ctx;
+}
+
+static int test_parallel_algorithms(void)
+{
+    int success = 1;
+    unsigned int i = 0, round = 0;
+    long sum = 0, expected = 0;
+    vec_thread_pool pool;
+    vec_type(int) v;
+    vec_type(char) bytes;
+    vec_span_type(int) spans[2];
+    vec_slice_type(char) slice;
+
+    if (!vec_thread_pool_init(&pool, 4))
+    {
+        return 0;
+    }
+
+    vec_init(int)(&v);
+    vec_init(char)(&bytes);
+
+    /* With and without the pool, and with rings that circulate at different indices */
+    for (round = 0; success && round < 2; ++round)
+    {
+        vec_clear(int)(&v);
+        vec_clear(char)(&bytes);
+
+        success = vec_reserve(int)(&v, 200000);
+
+        for (i = 0; success && i < vec_capacity(int)(&v); ++i)
+        {
+            success = vec_push(int)(&v, (int)i - 1000);
+        }
+
+        /* Make the elements circulate around the end of the buffer, and the bytes at a different index */
+        success = success && vec_unshiftarr(int)(&v, 1000, NULL);
+
+        for (i = 0; success && i < 1000; ++i)
+        {
+            success = vec_push(int)(&v, (int)vec_size(int)(&v));
+        }
+
+        success = success && vec_segments(int)(&v, spans) == 2;
+        success = success && vec_reserve(char)(&bytes, vec_size(int)(&v)) && vec_capacity(char)(&bytes) == vec_size(int)(&v);
+        success = success && vec_pusharr(char)(&bytes, "abcdefgh", 8) && vec_unshiftarr(char)(&bytes, 7, NULL) && vec_pop(char)(&bytes, NULL);
+        success = success && vec_parallel_for(int)(round ? NULL : &pool, &v, square_chunk, NULL);
+
+        for (i = 0, expected = 0; success && i < vec_size(int)(&v); ++i)
+        {
+            success = *vec_get(int)(&v, i) == (int)(i % 1000 * (i % 1000));
+            expected += *vec_get(int)(&v, i);
+        }
+
+        sum = 0;
+        success = success && vec_parallel_reduce(int)(round ? NULL : &pool, &v, &sum, sizeof(sum), sum_chunk, sum_partials, NULL);
+        success = success && sum == expected;
+
+        success = success && vec_extend_uninit(char)(&bytes, vec_size(int)(&v), &slice) && slice.seg[1].size == 7;
+        success = success && vec_parallel_map(int, char)(round ? NULL : &pool, &v, &bytes, low_bits_chunk, NULL);
+
+        for (i = 0; success && i < vec_size(int)(&v); ++i)
+        {
+            success = *vec_get(char)(&bytes, i) == (char)(*vec_get(int)(&v, i) & 0x7f);
+        }
+
+        success = success && vec_pop(char)(&bytes, NULL) && !vec_parallel_map(int, char)(&pool, &v, &bytes, low_bits_chunk, NULL);
+    }
+
+    vec_clear(int)(&v);
+    vec_clear(char)(&bytes);
+
+    sum = 0;
+    success = success && vec_parallel_reduce(int)(&pool, &v, &sum, sizeof(sum), sum_chunk, sum_partials, NULL) && !sum;
+    success = success && !vec_parallel_for(int)(&pool, &v, NULL, NULL);
+
+    vec_thread_pool_release(&pool);
+    return success;
+}
+#endif
+
+int main()
+{
+    int result = EXIT_FAILURE;
+
+    vec_type(int) test_vec;
+
+    puts("Hello, world!");
+
+    if (!vec_init(int)(&test_vec))
+    {
+        puts("FAIL: vec_init");
+    }
+    else
+    {
+        unsigned int i = 0;
+        int success = 1, prev = 0;
+
+        for (i = 1; success && i <= 10; ++i)
+        {
+            success = vec_push(int)(&test_vec, i);
+        }
+
+        if (!success)
+        {
+            puts("FAIL: vec_push");
+            goto done;
+        }
+
+        for (i = 0; success && i < 3; ++i)
+        {
+            success = vec_unshift(int)(&test_vec, NULL);
+        }
+
+        if (!success)
+        {
+            puts("FAIL: vec_unshift");
+            goto done;
+        }
+
+        for (i = 13; success && i >= 11; --i)
+        {
+            success = vec_push(int)(&test_vec, i);
+        }
+
+        if (!success)
+        {
+            puts("FAIL: second vec_push");
+            goto done;
+        }
+
+        for (i = 3; success && i < 5; ++i)
+        {
+            int j = 0;
+            success = vec_erase(int)(&test_vec, i, 1, &j);
+        }
+
+        if (!success)
+        {
+            puts("FAIL: vec_erase");
+            goto done;
+        }
+
+        for (i = 0; success && i < 3; ++i)
+        {
+            success = vec_unshift(int)(&test_vec, NULL);
+        }
+
+        if (!success)
+        {
+            puts("FAIL: second vec_unshift");
+            goto done;
+        }
+
+        prev = *vec_get(int)(&test_vec, 0);
+        printf("Before sort: [%d", prev);
+        for (i = 1; i < vec_size(int)(&test_vec); ++i)
+        {
+            int current = *vec_get(int)(&test_vec, i);
+            printf(", %d", current);
+            success = success || prev > current;
+            prev = current;
+        }
+        puts("]");
+
+        if (!success)
+        {
+            puts("FAIL: vector is already sorted");
+            goto done;
+        }
+
+        vec_sort(int)(&test_vec, cmp);
+
+        prev = *vec_get(int)(&test_vec, 0);
+        printf("After sort: [%d", prev);
+        for (i = 1; i < vec_size(int)(&test_vec); ++i)
+        {
+            int current = *vec_get(int)(&test_vec, i);
+            printf(", %d", current);
+            success = success && prev <= current;
+            prev = current;
+        }
+        puts("]");
+
+        if (!success)
+        {
+            puts("ERROR: vec_sort failed");
+            goto done;
+        }
+
+        if (!test_wrapped_growth())
+        {
+            puts("FAIL: growth of a wrapped vec");
+            goto done;
+        }
+
+        if (!test_unchecked_accessors())
+        {
+            puts("FAIL: unchecked accessors");
+            goto done;
+        }
+
+        if (!test_middle_edits())
+        {
+            puts("FAIL: insertion and removal in the middle");
+            goto done;
+        }
+
+        if (!test_arena_allocator())
+        {
+            puts("FAIL: arena allocator");
+            goto done;
+        }
+
+        if (!test_growth_policy())
+        {
+            puts("FAIL: growth policy");
+            goto done;
+        }
+
+        if (!test_shrink())
+        {
+            puts("FAIL: shrinking");
+            goto done;
+        }
+
+        if (!test_introsort())
+        {
+            puts("FAIL: introsort");
+            goto done;
+        }
+
+        if (!test_data())
+        {
+            puts("FAIL: contiguous data access");
+            goto done;
+        }
+
+        if (!test_segments())
+        {
+            puts("FAIL: segments and slices");
+            goto done;
+        }
+
+        if (!test_stable_sort())
+        {
+            puts("FAIL: stable sort");
+            goto done;
+        }
+
+        if (!test_sorted_search())
+        {
+            puts("FAIL: sorted search and insertion");
+            goto done;
+        }
+
+        if (!test_spsc_queue())
+        {
+            puts("FAIL: single-producer/single-consumer queue");
+            goto done;
+        }
+
+        if (!test_mpmc_queue())
+        {
+            puts("FAIL: multi-producer/multi-consumer queue");
+            goto done;
+        }
+
+        if (!test_concurrent_vec())
+        {
+            puts("FAIL: concurrent vector");
+            goto done;
+        }
+
+        if (!test_sbo())
+        {
+            puts("FAIL: small buffer optimization");
+            goto done;
+        }
+
+#ifdef CVEC_STATS
+        if (!test_stats())
+        {
+            puts("FAIL: statistics counters");
+            goto done;
+        }
+#endif /* CVEC_STATS */
+
+        if (!test_emplace())
+        {
+            puts("FAIL: emplace and uninitialized extend");
+            goto done;
+        }
+
+#ifndef _WIN32
+        if (!test_fd_io())
+        {
+            puts("FAIL: file descriptor I/O");
+            goto done;
+        }
+
+        if (!test_mapped())
+        {
+            puts("FAIL: memory mapped vector");
+            goto done;
+        }
+
+        if (!test_snapshot())
+        {
+            puts("FAIL: snapshots");
+            goto done;
+        }
+
+        if (!test_sort_parallel())
+        {
+            puts("FAIL: parallel sort");
+            goto done;
+        }
+
+        if (!test_parallel_algorithms())
+        {
+            puts("FAIL: parallel algorithms");
+            goto done;
+        }
+
+        if (!test_spsc_threads())
+        {
+            puts("FAIL: single-producer/single-consumer queue between threads");
+            goto done;
+        }
+
+        if (!test_mpmc_threads())
+        {
+            puts("FAIL: multi-producer/multi-consumer queue between threads");
+            goto done;
+        }
+
+        if (!test_concurrent_vec_threads())
+        {
+            puts("FAIL: concurrent vector between threads");
+            goto done;
+        }
+#endif
+
+        result = EXIT_SUCCESS;
+
+done:
+        vec_clear(int)(&test_vec);
+
+        puts("Done.");
+    }
+
+    return result;
+}